@@ -0,0 +1,297 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+
+#include "batch.h"
+#include "graph_as_vector.h"
+#include "kruskal.h"
+#include "ghs.h"
+#include "compact_ghs.h"
+#include "static_node.h"
+#include "mst_cache.h"
+
+namespace
+{
+
+const char MAGIC[] = {'M', 'S', 'T', 'B'};
+const char* const ENGINE_NAMES[] = {"kruskal", "ghs", "gkp", "boruvka", "compact", "static"};
+
+struct Batch_job
+{
+    size_t index;
+    Mst_engine engine;
+    Graph_as_vector graph;
+    bool valid;
+};
+
+void put_varint(std::ostream& stream, size_t value)
+{
+    for(; value >= 0x80; value >>= 7)
+        stream.put(static_cast<char>(value | 0x80));
+    stream.put(static_cast<char>(value));
+}
+
+size_t get_varint(std::istream& stream)
+{
+    size_t result = 0;
+    for(size_t shift = 0; ; shift += 7)
+    {
+        int byte = stream.get();
+        if(byte == std::char_traits<char>::eof() || shift >= 64)
+            throw bad_batch();
+
+        result |= static_cast<size_t>(byte & 0x7f) << shift;
+        if((byte & 0x80) == 0)
+            return result;
+    }
+}
+
+bool has_valid_nodes(const Graph_as_vector& graph)
+{
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+        if(graph[i].get_first_node() >= graph.get_node_num() || graph[i].get_second_node() >= graph.get_node_num())
+            return false;
+
+    return true;
+}
+
+bool read_job(std::istream& stream, Batch_job& job)
+{
+    stream >> std::ws;
+    int first = stream.peek();
+    if(first == std::char_traits<char>::eof())
+        return false;
+
+    job.graph = Graph_as_vector();
+
+    if(first == MAGIC[0])
+    {
+        for(char i : MAGIC)
+            if(stream.get() != i)
+                throw bad_batch();
+
+        int engine = stream.get();
+        if(engine < 0 || engine > STATIC_GHS_MST)
+            throw bad_batch();
+        job.engine = Mst_engine(engine);
+
+        job.graph.set_node_num(get_varint(stream));
+        size_t edge_num = get_varint(stream);
+        for(size_t i = 0; i < edge_num; ++i)
+        {
+            size_t first_node = get_varint(stream), second_node = get_varint(stream);
+            job.graph.add_edge(Graph_as_vector::Edge(first_node, second_node, get_varint(stream)));
+        }
+    }
+    else
+    {
+        std::string name;
+        stream >> name;
+        job.engine = parse_engine(name);
+
+        stream >> job.graph;
+        if(!stream)
+            throw bad_batch();
+    }
+
+    job.valid = has_valid_nodes(job.graph);
+
+    return true;
+}
+
+std::string format_result(const Batch_job& job, Mst_cache* cache)
+{
+    std::ostringstream stream;
+    stream << "graph " << job.index << " " << engine_name(job.engine);
+
+    try
+    {
+        if(!job.valid)
+            throw bad_batch();
+
+        Graph_as_vector result = !cache ? run_engine(job.graph, job.engine, job.index) : cache->compute(job.graph, engine_name(job.engine), [&job](const Graph_as_vector& graph)
+        {
+            return run_engine(graph, job.engine, job.index);
+        });
+
+        size_t weight = 0;
+        for(size_t i = 0; i < result.get_edge_num(); ++i)
+            weight += result[i].get_weight();
+
+        stream << " " << result.get_edge_num() << " " << weight << std::endl << result;
+    }
+    catch(const std::exception&)
+    {
+        stream << " error" << std::endl;
+    }
+
+    return stream.str();
+}
+
+}
+
+Mst_engine parse_engine(const std::string& name)
+{
+    for(size_t i = 0; i <= STATIC_GHS_MST; ++i)
+        if(name == ENGINE_NAMES[i])
+            return Mst_engine(i);
+
+    throw bad_batch();
+}
+
+const char* engine_name(Mst_engine engine)
+{
+    return ENGINE_NAMES[engine];
+}
+
+Graph_as_vector run_engine(const Graph_as_vector& graph, Mst_engine engine, size_t seed)
+{
+    Ghs_stats stats;
+
+    switch(engine)
+    {
+    case GHS_MST:
+        return ghs(graph, Ghs_options(seed, GHS_PROTOCOL));
+    case GKP_MST:
+        return ghs(graph, Ghs_options(seed, GKP_PROTOCOL));
+    case BORUVKA_MST:
+        return ghs(graph, Ghs_options(seed, BORUVKA_PROTOCOL));
+    case COMPACT_GHS_MST:
+        return compact_ghs(graph);
+    case STATIC_GHS_MST:
+        return static_ghs(graph, seed, stats);
+    default:
+        return mst(graph, 1);
+    }
+}
+
+void write_batch_graph(std::ostream& stream, const Graph_as_vector& graph, Mst_engine engine)
+{
+    stream.write(MAGIC, sizeof(MAGIC));
+    stream.put(static_cast<char>(engine));
+
+    put_varint(stream, graph.get_node_num());
+    put_varint(stream, graph.get_edge_num());
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+    {
+        put_varint(stream, graph[i].get_first_node());
+        put_varint(stream, graph[i].get_second_node());
+        put_varint(stream, graph[i].get_weight());
+    }
+}
+
+size_t process_batch(std::istream& input, std::ostream& output, size_t thread_num, size_t window, Mst_cache* cache)
+{
+    if(thread_num == 0)
+        thread_num = std::max(1u, std::thread::hardware_concurrency());
+    if(window == 0)
+        window = 4 * thread_num;
+
+    std::mutex mutex;
+    std::condition_variable job_ready, result_ready, space_ready;
+    std::queue<Batch_job> jobs;
+    std::map<size_t, std::string> results;
+    size_t job_num = 0, in_flight = 0;
+    bool input_done = false;
+
+    std::vector<std::thread> workers;
+    for(size_t t = 0; t < thread_num; ++t)
+        workers.emplace_back([&]()
+        {
+            while(true)
+            {
+                Batch_job job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    job_ready.wait(lock, [&]()
+                    {
+                        return !jobs.empty() || input_done;
+                    });
+                    if(jobs.empty())
+                        return;
+
+                    job = std::move(jobs.front());
+                    jobs.pop();
+                }
+
+                std::string text = format_result(job, cache);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                results.emplace(job.index, std::move(text));
+                result_ready.notify_one();
+            }
+        });
+
+    std::thread writer([&]()
+    {
+        for(size_t next = 0; ; ++next)
+        {
+            std::string text;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                result_ready.wait(lock, [&]()
+                {
+                    return results.count(next) || (input_done && next == job_num);
+                });
+                if(!results.count(next))
+                    return;
+
+                text = std::move(results[next]);
+                results.erase(next);
+            }
+
+            output << text;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            --in_flight;
+            space_ready.notify_one();
+        }
+    });
+
+    bool failed = false;
+    try
+    {
+        Batch_job job;
+        while(read_job(input, job))
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            space_ready.wait(lock, [&]()
+            {
+                return in_flight < window;
+            });
+
+            job.index = job_num++;
+            ++in_flight;
+            jobs.push(std::move(job));
+            job_ready.notify_one();
+        }
+    }
+    catch(const std::exception&)
+    {
+        failed = true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        input_done = true;
+    }
+    job_ready.notify_all();
+    result_ready.notify_all();
+
+    for(std::thread& i : workers)
+        i.join();
+    writer.join();
+    output.flush();
+
+    if(failed)
+        throw bad_batch();
+
+    return job_num;
+}
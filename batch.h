@@ -0,0 +1,24 @@
+#ifndef BATCH_H_INCLUDED
+#define BATCH_H_INCLUDED
+
+#include <iostream>
+#include <string>
+#include <stdexcept>
+
+#include "graph_as_vector.h"
+#include "mst_cache.h"
+
+class bad_batch : public std::exception
+{
+};
+
+enum Mst_engine : unsigned char {KRUSKAL_MST, GHS_MST, GKP_MST, BORUVKA_MST, COMPACT_GHS_MST, STATIC_GHS_MST};
+
+Mst_engine parse_engine(const std::string& name);
+const char* engine_name(Mst_engine engine);
+Graph_as_vector run_engine(const Graph_as_vector& graph, Mst_engine engine, size_t seed);
+
+void write_batch_graph(std::ostream& stream, const Graph_as_vector& graph, Mst_engine engine);
+size_t process_batch(std::istream& input, std::ostream& output, size_t thread_num = 0, size_t window = 0, Mst_cache* cache = nullptr);
+
+#endif // BATCH_H_INCLUDED
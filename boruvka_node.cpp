@@ -0,0 +1,376 @@
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <utility>
+#include <limits>
+#include <memory>
+
+#include "boruvka_node.h"
+#include "emulator.h"
+
+unsigned char Boruvka_query::get_type() const
+{
+    return type;
+}
+
+const char* Boruvka_query::get_name() const
+{
+    static const char* const NAMES[] = {"ID", "REPORT", "DECISION", "CHOICE", "NEW_FRAGMENT", "END"};
+    return NAMES[type];
+}
+
+size_t Boruvka_query::get_payload(size_t i) const
+{
+    return i == 0 ? value : height;
+}
+
+Boruvka_node::Boruvka_node() : id(0), fragment(0), parent(0), phase(0), phase_cap(UDEF), depth_cap(UDEF), height(0), state(Boruvka_node::SLEEP), local_best(INF_WEIGHT), subtree_best(INF_WEIGHT), report_num(0), report_best(INF_WEIGHT), report_height(0), pending_fragment(UDEF), pending_parent(UDEF)
+{
+}
+
+void Boruvka_node::set_id(size_t id_)
+{
+    id = fragment = parent = id_;
+}
+
+void Boruvka_node::add_edge(size_t end, size_t weight)
+{
+    links.push_back(Link(end, weight));
+}
+
+Graph_as_vector Boruvka_node::get_branches() const
+{
+    Graph_as_vector result;
+
+    for(const Link& i : links)
+        if(i.state == BRANCH)
+            result.add_edge(Graph_as_vector::Edge(id, i.end, i.weight));
+
+    return result;
+}
+
+bool Boruvka_node::ended() const
+{
+    return state == Boruvka_node::END;
+}
+
+unsigned char Boruvka_node::get_state() const
+{
+    return state;
+}
+
+size_t Boruvka_node::get_priority() const
+{
+    return phase;
+}
+
+size_t Boruvka_node::get_fragment() const
+{
+    return fragment;
+}
+
+size_t Boruvka_node::get_signature() const
+{
+    size_t signature = Emulator_node::get_signature();
+    for(size_t i : {parent, report_num, pending_fragment})
+        signature = mix_signature(signature, i);
+    for(const Link& i : links)
+        signature = mix_signature(signature, i.state | i.outgoing << 2 | i.chosen << 3 | (i.ids.size() + i.choices.size()) << 4);
+
+    return signature;
+}
+
+size_t Boruvka_node::get_phase_num() const
+{
+    return phase + 1;
+}
+
+void Boruvka_node::set_phase_cap(size_t phase_cap_)
+{
+    phase_cap = phase_cap_;
+}
+
+void Boruvka_node::set_depth_cap(size_t depth_cap_)
+{
+    depth_cap = depth_cap_;
+}
+
+const std::deque<std::shared_ptr<const Emulator_query>>& Boruvka_node::wake_up()
+{
+    result = std::deque<std::shared_ptr<const Emulator_query>>();
+
+    if(state == Boruvka_node::SLEEP)
+        start_phase();
+
+    return result;
+}
+
+const std::deque<std::shared_ptr<const Emulator_query>>& Boruvka_node::tick(std::shared_ptr<const Emulator_query> q_)
+{
+    result = std::deque<std::shared_ptr<const Emulator_query>>();
+
+    if(state == Boruvka_node::SLEEP)
+        start_phase();
+
+    const Boruvka_query& q = *std::static_pointer_cast<const Boruvka_query>(q_);
+
+    switch(q.type)
+    {
+    case Boruvka_query::ID:
+        on_id(q.get_sender(), q.value);
+        break;
+    case Boruvka_query::REPORT:
+        on_report(q.value, q.height);
+        break;
+    case Boruvka_query::DECISION:
+        decide(q.value, q.height);
+        break;
+    case Boruvka_query::CHOICE:
+        on_choice(q.get_sender(), q.value != 0, q.height);
+        break;
+    case Boruvka_query::NEW_FRAGMENT:
+        on_new_fragment(q.get_sender(), q.value);
+        break;
+    case Boruvka_query::END:
+        end();
+        break;
+    }
+
+    return result;
+}
+
+size_t Boruvka_node::get_link(size_t end) const
+{
+    return std::distance(links.begin(), std::find_if(links.begin(), links.end(), [end](const Link& l)
+    {
+        return l.end == end;
+    }));
+}
+
+bool Boruvka_node::is_head(size_t f) const
+{
+    return mix_signature(mix_signature(f, phase), phase) >> (std::numeric_limits<size_t>::digits - 1);
+}
+
+bool Boruvka_node::may_hook() const
+{
+    return depth_cap == UDEF || (!is_head(fragment) && height < depth_cap);
+}
+
+void Boruvka_node::send(size_t recipient, Boruvka_query::Type type, size_t value, size_t height_)
+{
+    result.push_back(std::make_shared<Boruvka_query>(id, recipient, type, value, height_));
+}
+
+void Boruvka_node::send_children(Boruvka_query::Type type, size_t value, size_t except, size_t height_)
+{
+    std::vector<size_t> children;
+    for(const Link& i : links)
+        if(i.state == BRANCH && i.end != except)
+            children.push_back(i.end);
+
+    if(children.size() == 1)
+        send(children.front(), type, value, height_);
+    else if(!children.empty())
+        result.push_back(std::make_shared<Emulator_multicast>(std::move(children), std::make_shared<Boruvka_query>(id, Emulator_query::MULTICAST, type, value, height_)));
+}
+
+void Boruvka_node::start_phase()
+{
+    state = Boruvka_node::EXCHANGE;
+
+    for(const Link& i : links)
+        if(i.state == UNKNOWN)
+            send(i.end, Boruvka_query::ID, fragment);
+
+    check_exchange();
+}
+
+void Boruvka_node::on_id(size_t sender, size_t f)
+{
+    links[get_link(sender)].ids.push_back(f);
+
+    if(state == Boruvka_node::EXCHANGE)
+        check_exchange();
+}
+
+void Boruvka_node::check_exchange()
+{
+    for(const Link& i : links)
+        if(i.state == UNKNOWN && i.ids.empty())
+            return;
+
+    local_best = INF_WEIGHT;
+    for(Link& i : links)
+        if(i.state == UNKNOWN)
+        {
+            size_t f = i.ids.front();
+            i.ids.pop_front();
+
+            if(f == fragment)
+                i.state = REJECTED;
+            else
+            {
+                i.outgoing = true;
+                i.fragment = f;
+                local_best = std::min(local_best, i.weight);
+            }
+        }
+        else if(i.state == CLOSED)
+            local_best = std::min(local_best, i.weight);
+
+    state = Boruvka_node::CONVERGECAST;
+    check_reports();
+}
+
+void Boruvka_node::on_report(size_t weight, size_t height_)
+{
+    ++report_num;
+    report_best = std::min(report_best, weight);
+    report_height = std::max(report_height, height_ + 1);
+
+    if(state == Boruvka_node::CONVERGECAST)
+        check_reports();
+}
+
+void Boruvka_node::check_reports()
+{
+    size_t children_num = 0;
+    for(const Link& i : links)
+        if(i.state == BRANCH && i.end != parent)
+            ++children_num;
+
+    if(report_num < children_num)
+        return;
+
+    size_t subtree_height = report_height;
+    subtree_best = std::min(local_best, report_best);
+    report_num = report_height = 0;
+    report_best = INF_WEIGHT;
+
+    if(parent == id)
+        decide(subtree_best, subtree_height);
+    else
+    {
+        state = Boruvka_node::BROADCAST;
+        send(parent, Boruvka_query::REPORT, subtree_best, subtree_height);
+    }
+}
+
+void Boruvka_node::decide(size_t weight, size_t height_)
+{
+    if(weight == INF_WEIGHT)
+    {
+        end();
+        return;
+    }
+
+    state = Boruvka_node::MERGE;
+    height = height_;
+    send_children(Boruvka_query::DECISION, weight, parent, height);
+
+    for(Link& i : links)
+        if(i.outgoing)
+        {
+            i.chosen = i.weight == weight;
+            send(i.end, Boruvka_query::CHOICE, i.chosen && may_hook(), height);
+        }
+        else if(i.state == CLOSED)
+            i.chosen = i.weight == weight;
+
+    check_choices();
+}
+
+void Boruvka_node::on_choice(size_t sender, bool merge, size_t height_)
+{
+    links[get_link(sender)].choices.push_back(std::make_pair(merge, height_));
+
+    if(state == Boruvka_node::MERGE)
+        check_choices();
+}
+
+void Boruvka_node::check_choices()
+{
+    for(const Link& i : links)
+        if(i.outgoing && i.choices.empty())
+            return;
+
+    size_t core = UDEF;
+    for(Link& i : links)
+        if(i.outgoing)
+        {
+            bool merge = i.choices.front().first;
+            size_t end_height = i.choices.front().second;
+            i.choices.pop_front();
+
+            if(depth_cap == UDEF)
+            {
+                if(i.chosen || merge)
+                    i.state = BRANCH;
+                if(i.chosen && merge)
+                    core = i.end;
+            }
+            else
+            {
+                bool hook = i.chosen && may_hook() && is_head(i.fragment) && end_height < depth_cap;
+                if(hook || (merge && is_head(fragment) && height < depth_cap))
+                    i.state = BRANCH;
+                else if(end_height >= depth_cap)
+                    i.state = CLOSED;
+                if(i.chosen && !hook)
+                    core = id;
+            }
+
+            i.outgoing = i.chosen = false;
+        }
+        else if(i.chosen)
+        {
+            core = id;
+            i.chosen = false;
+        }
+
+    state = Boruvka_node::RELABEL;
+
+    if(height >= depth_cap)
+        state = Boruvka_node::END;
+    else if(core == id)
+        relabel(fragment, id, id);
+    else if(core != UDEF)
+    {
+        size_t leader = std::max(id, core);
+        relabel(leader, leader, core);
+    }
+    else if(pending_parent != UDEF)
+        relabel(pending_fragment, pending_parent, pending_parent);
+}
+
+void Boruvka_node::on_new_fragment(size_t sender, size_t f)
+{
+    if(state == Boruvka_node::RELABEL)
+        relabel(f, sender, sender);
+    else
+    {
+        pending_fragment = f;
+        pending_parent = sender;
+    }
+}
+
+void Boruvka_node::relabel(size_t fragment_, size_t parent_, size_t except)
+{
+    fragment = fragment_;
+    parent = parent_;
+    pending_fragment = pending_parent = UDEF;
+
+    send_children(Boruvka_query::NEW_FRAGMENT, fragment, except);
+
+    if(++phase == phase_cap)
+        state = Boruvka_node::END;
+    else
+        start_phase();
+}
+
+void Boruvka_node::end()
+{
+    state = Boruvka_node::END;
+    send_children(Boruvka_query::END, 0, parent);
+}
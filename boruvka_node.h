@@ -0,0 +1,97 @@
+#ifndef BORUVKA_NODE_H_INCLUDED
+#define BORUVKA_NODE_H_INCLUDED
+
+#include <vector>
+#include <deque>
+#include <utility>
+#include <limits>
+#include <memory>
+
+#include "graph_as_vector.h"
+#include "emulator.h"
+#include "ghs.h"
+
+struct Boruvka_query : public Emulator_query
+{
+    enum Type : unsigned char {ID, REPORT, DECISION, CHOICE, NEW_FRAGMENT, END};
+
+    Type type;
+    size_t value, height;
+
+    Boruvka_query(size_t sender, size_t recipient, Type type, size_t value = 0, size_t height = 0) : Emulator_query(sender, recipient), type(type), value(value), height(height) {};
+
+    virtual unsigned char get_type() const override;
+    virtual const char* get_name() const override;
+    virtual size_t get_payload(size_t i) const override;
+};
+
+class Boruvka_node : public Emulator_node, public Ghs_node
+{
+public:
+    enum State {SLEEP, EXCHANGE, CONVERGECAST, BROADCAST, MERGE, RELABEL, END};
+
+private:
+    enum Link_state {UNKNOWN, REJECTED, BRANCH, CLOSED};
+
+    struct Link
+    {
+        size_t end, weight, fragment;
+        Link_state state;
+        bool outgoing, chosen;
+        std::deque<size_t> ids;
+        std::deque<std::pair<bool, size_t>> choices;
+
+        Link(size_t end, size_t weight) : end(end), weight(weight), fragment(0), state(UNKNOWN), outgoing(false), chosen(false) {};
+    };
+
+    static constexpr size_t UDEF = std::numeric_limits<size_t>::max();
+    static constexpr size_t INF_WEIGHT = std::numeric_limits<size_t>::max();
+
+    size_t id, fragment, parent, phase, phase_cap, depth_cap, height;
+    State state;
+
+    size_t local_best, subtree_best, report_num, report_best, report_height;
+    size_t pending_fragment, pending_parent;
+
+    std::vector<Link> links;
+    std::deque<std::shared_ptr<const Emulator_query>> result;
+
+    size_t get_link(size_t end) const;
+    bool is_head(size_t f) const;
+    bool may_hook() const;
+    void send(size_t recipient, Boruvka_query::Type type, size_t value = 0, size_t height_ = 0);
+    void send_children(Boruvka_query::Type type, size_t value, size_t except, size_t height_ = 0);
+
+    void start_phase();
+    void check_exchange();
+    void check_reports();
+    void decide(size_t weight, size_t height_);
+    void check_choices();
+    void relabel(size_t fragment_, size_t parent_, size_t except);
+    void end();
+
+    void on_id(size_t sender, size_t f);
+    void on_report(size_t weight, size_t height_);
+    void on_choice(size_t sender, bool merge, size_t height_);
+    void on_new_fragment(size_t sender, size_t f);
+
+public:
+    Boruvka_node();
+
+    virtual void set_id(size_t id_) override;
+    virtual const std::deque<std::shared_ptr<const Emulator_query>>& tick(std::shared_ptr<const Emulator_query> q) override;
+    virtual Graph_as_vector get_branches() const override;
+    virtual void add_edge(size_t end, size_t weight) override;
+    virtual const std::deque<std::shared_ptr<const Emulator_query>>& wake_up() override;
+    virtual bool ended() const override;
+    virtual unsigned char get_state() const override;
+    virtual size_t get_priority() const override;
+    virtual size_t get_fragment() const override;
+    virtual size_t get_signature() const override;
+    virtual size_t get_phase_num() const override;
+
+    void set_phase_cap(size_t phase_cap_);
+    void set_depth_cap(size_t depth_cap_);
+};
+
+#endif // BORUVKA_NODE_H_INCLUDED
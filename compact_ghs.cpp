@@ -0,0 +1,7 @@
+#include <cstddef>
+
+#include "compact_ghs.h"
+#include "graph_as_vector.h"
+
+template class Basic_compact_ghs<size_t, size_t>;
+template Graph_as_vector compact_ghs(const Graph_as_vector& graph);
@@ -0,0 +1,424 @@
+#ifndef COMPACT_GHS_H_INCLUDED
+#define COMPACT_GHS_H_INCLUDED
+
+#include <vector>
+#include <deque>
+#include <limits>
+
+#include "graph_as_vector.h"
+#include "mailbox.h"
+#include "emulator.h"
+#include "random.h"
+
+template<typename Index, typename Weight>
+struct Basic_compact_message
+{
+    enum Type : unsigned char {INIT, CHANGE_CORE, CONNECT, REJECT, REPORT, TEST, ACCEPT, END};
+
+    Type type;
+    unsigned char state, level;
+    Index recipient;
+    size_t edge;
+    Weight value;
+};
+
+template<typename Index, typename Weight>
+class Basic_compact_ghs
+{
+public:
+    enum State : unsigned char {SLEEP, FOUND, SEARCH, END};
+    enum Edge_state : unsigned char {UNKNOWN, REJECTED, BRANCH};
+
+    typedef Basic_compact_message<Index, Weight> Message;
+    typedef Basic_graph_as_vector<Index, Weight> Graph;
+
+    static constexpr size_t UDEF = std::numeric_limits<size_t>::max();
+    static constexpr Weight INF_WEIGHT = infinite_weight<Weight>();
+
+private:
+    Index node_num, ended_num;
+    size_t message_num;
+
+    std::vector<size_t> offsets, mates;
+    std::vector<Index> ends;
+    std::vector<Weight> weights;
+    std::vector<Edge_state> edge_states;
+
+    std::vector<State> states;
+    std::vector<unsigned char> levels;
+    std::vector<bool> checking_postponed;
+    std::vector<Weight> fragments, best_edge_weights;
+    std::vector<size_t> parents, best_edges, test_edges;
+    std::vector<Index> reports;
+
+    Mailbox<Message> postponed;
+    std::deque<Message> in_flight;
+
+    size_t find_min_edge(Index v) const;
+    Index sons_num(Index v) const;
+    void send(size_t e, Message q);
+    void broadcast(Index v, Message q);
+    void postpone(const Message& q);
+    void finish(Index v);
+    void test(Index v);
+    void report(Index v);
+    void change_core(Index v);
+    void check_postponed(Index v);
+    void wake_up(Index v);
+    void tick(const Message& q);
+    void random_wake_up();
+
+public:
+    Basic_compact_ghs(const Graph& graph);
+
+    void process();
+
+    Graph get_branches() const;
+    size_t get_message_num() const;
+};
+
+typedef Basic_compact_message<size_t, size_t> Compact_message;
+typedef Basic_compact_ghs<size_t, size_t> Compact_ghs;
+
+template<typename Index, typename Weight>
+Basic_graph_as_vector<Index, Weight> compact_ghs(const Basic_graph_as_vector<Index, Weight>& graph);
+
+template<typename Index, typename Weight>
+Basic_compact_ghs<Index, Weight>::Basic_compact_ghs(const Graph& graph) :
+    node_num(graph.get_node_num()), ended_num(0), message_num(0),
+    offsets(node_num + 1, 0), mates(2 * graph.get_edge_num()), ends(2 * graph.get_edge_num()),
+    weights(2 * graph.get_edge_num()), edge_states(2 * graph.get_edge_num(), UNKNOWN),
+    states(node_num, SLEEP), levels(node_num, 0), checking_postponed(node_num, false),
+    fragments(node_num, INF_WEIGHT), best_edge_weights(node_num, INF_WEIGHT),
+    parents(node_num, UDEF), best_edges(node_num, UDEF), test_edges(node_num, UDEF), reports(node_num, 0),
+    postponed(node_num)
+{
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+    {
+        ++offsets[graph[i].get_first_node() + 1];
+        ++offsets[graph[i].get_second_node() + 1];
+    }
+    for(Index i = 0; i < node_num; ++i)
+        offsets[i + 1] += offsets[i];
+
+    std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+    {
+        size_t a = fill[graph[i].get_first_node()]++;
+        size_t b = fill[graph[i].get_second_node()]++;
+
+        ends[a] = graph[i].get_second_node();
+        ends[b] = graph[i].get_first_node();
+        weights[a] = weights[b] = graph[i].get_weight();
+        mates[a] = b;
+        mates[b] = a;
+    }
+}
+
+template<typename Index, typename Weight>
+size_t Basic_compact_ghs<Index, Weight>::find_min_edge(Index v) const
+{
+    size_t min = UDEF;
+    Weight min_weight = INF_WEIGHT;
+    for(size_t i = offsets[v]; i < offsets[v + 1]; ++i)
+        if(edge_states[i] == UNKNOWN && weights[i] < min_weight)
+        {
+            min = i;
+            min_weight = weights[i];
+        }
+    return min;
+}
+
+template<typename Index, typename Weight>
+Index Basic_compact_ghs<Index, Weight>::sons_num(Index v) const
+{
+    Index result = 0;
+    for(size_t i = offsets[v]; i < offsets[v + 1]; ++i)
+        result += edge_states[i] == BRANCH && i != parents[v];
+    return result;
+}
+
+template<typename Index, typename Weight>
+void Basic_compact_ghs<Index, Weight>::send(size_t e, Message q)
+{
+    q.recipient = ends[e];
+    q.edge = mates[e];
+    in_flight.push_back(q);
+    ++message_num;
+}
+
+template<typename Index, typename Weight>
+void Basic_compact_ghs<Index, Weight>::broadcast(Index v, Message q)
+{
+    for(size_t i = offsets[v]; i < offsets[v + 1]; ++i)
+        if(edge_states[i] == BRANCH && i != parents[v])
+            send(i, q);
+}
+
+template<typename Index, typename Weight>
+void Basic_compact_ghs<Index, Weight>::postpone(const Message& q)
+{
+    postponed.push_back(q.recipient, q);
+}
+
+template<typename Index, typename Weight>
+void Basic_compact_ghs<Index, Weight>::check_postponed(Index v)
+{
+    if(checking_postponed[v])
+        return;
+
+    size_t num = postponed.length(v);
+
+    checking_postponed[v] = true;
+    for(size_t i = 0; i < num; ++i)
+    {
+        Message q = postponed.front(v);
+        postponed.pop_front(v);
+
+        tick(q);
+    }
+    checking_postponed[v] = false;
+}
+
+template<typename Index, typename Weight>
+void Basic_compact_ghs<Index, Weight>::finish(Index v)
+{
+    if(states[v] != END)
+        ++ended_num;
+    states[v] = END;
+}
+
+template<typename Index, typename Weight>
+void Basic_compact_ghs<Index, Weight>::test(Index v)
+{
+    size_t min_edge = find_min_edge(v);
+    test_edges[v] = min_edge;
+    if(min_edge != UDEF)
+        send(min_edge, Message{Message::TEST, 0, levels[v], 0, 0, fragments[v]});
+    else
+        report(v);
+}
+
+template<typename Index, typename Weight>
+void Basic_compact_ghs<Index, Weight>::report(Index v)
+{
+    if(sons_num(v) == reports[v] && test_edges[v] == UDEF)
+    {
+        states[v] = FOUND;
+        send(parents[v], Message{Message::REPORT, 0, 0, 0, 0, best_edge_weights[v]});
+
+        check_postponed(v);
+    }
+}
+
+template<typename Index, typename Weight>
+void Basic_compact_ghs<Index, Weight>::change_core(Index v)
+{
+    size_t e = best_edges[v];
+    if(edge_states[e] == BRANCH)
+        send(e, Message{Message::CHANGE_CORE, 0, 0, 0, 0, 0});
+    else
+    {
+        send(e, Message{Message::CONNECT, 0, levels[v], 0, 0, 0});
+        edge_states[e] = BRANCH;
+
+        check_postponed(v);
+    }
+}
+
+template<typename Index, typename Weight>
+void Basic_compact_ghs<Index, Weight>::wake_up(Index v)
+{
+    if(states[v] != SLEEP)
+        return;
+
+    best_edges[v] = find_min_edge(v);
+    if(best_edges[v] != UDEF)
+    {
+        states[v] = FOUND;
+        edge_states[best_edges[v]] = BRANCH;
+        send(best_edges[v], Message{Message::CONNECT, 0, levels[v], 0, 0, 0});
+    }
+    else
+        finish(v);
+}
+
+template<typename Index, typename Weight>
+void Basic_compact_ghs<Index, Weight>::tick(const Message& q)
+{
+    Index v = q.recipient;
+    size_t e = q.edge;
+
+    wake_up(v);
+
+    switch(q.type)
+    {
+    case Message::INIT:
+        fragments[v] = q.value;
+        levels[v] = q.level;
+        states[v] = static_cast<State>(q.state);
+        parents[v] = e;
+        best_edges[v] = UDEF;
+        best_edge_weights[v] = INF_WEIGHT;
+
+        broadcast(v, q);
+
+        if(states[v] == SEARCH)
+        {
+            reports[v] = 0;
+            test(v);
+        }
+
+        check_postponed(v);
+        break;
+
+    case Message::CHANGE_CORE:
+        change_core(v);
+        break;
+
+    case Message::CONNECT:
+        if(q.level < levels[v])
+        {
+            edge_states[e] = BRANCH;
+            send(e, Message{Message::INIT, states[v], levels[v], 0, 0, fragments[v]});
+        }
+        else if(edge_states[e] == BRANCH)
+            send(e, Message{Message::INIT, SEARCH, static_cast<unsigned char>(levels[v] + 1), 0, 0, weights[e]});
+        else
+            postpone(q);
+        break;
+
+    case Message::REJECT:
+        if(edge_states[e] == UNKNOWN)
+            edge_states[e] = REJECTED;
+
+        test(v);
+        break;
+
+    case Message::REPORT:
+        if(e != parents[v])
+        {
+            if(q.value < best_edge_weights[v])
+            {
+                best_edge_weights[v] = q.value;
+                best_edges[v] = e;
+            }
+
+            ++reports[v];
+            report(v);
+        }
+        else if(states[v] == SEARCH)
+            postpone(q);
+        else if(q.value > best_edge_weights[v])
+            change_core(v);
+        else if(q.value == INF_WEIGHT && best_edge_weights[v] == INF_WEIGHT)
+        {
+            finish(v);
+            broadcast(v, Message{Message::END, 0, 0, 0, 0, 0});
+        }
+        break;
+
+    case Message::TEST:
+        if(q.value == fragments[v])
+        {
+            if(edge_states[e] == UNKNOWN)
+                edge_states[e] = REJECTED;
+
+            if(e != test_edges[v])
+                send(e, Message{Message::REJECT, 0, 0, 0, 0, 0});
+            else
+                test(v);
+        }
+        else if(q.level <= levels[v])
+            send(e, Message{Message::ACCEPT, 0, 0, 0, 0, 0});
+        else
+            postpone(q);
+        break;
+
+    case Message::ACCEPT:
+        test_edges[v] = UDEF;
+
+        if(weights[e] < best_edge_weights[v])
+        {
+            best_edge_weights[v] = weights[e];
+            best_edges[v] = e;
+        }
+
+        report(v);
+        break;
+
+    case Message::END:
+        finish(v);
+        broadcast(v, q);
+        break;
+    }
+}
+
+template<typename Index, typename Weight>
+void Basic_compact_ghs<Index, Weight>::random_wake_up()
+{
+    Index start = rnd(0, node_num - 1);
+    for(Index i = 0; i < node_num; ++i)
+    {
+        Index v = (start + i) % node_num;
+        if(states[v] == SLEEP)
+        {
+            wake_up(v);
+            return;
+        }
+    }
+
+    throw bad_ghs();
+}
+
+template<typename Index, typename Weight>
+void Basic_compact_ghs<Index, Weight>::process()
+{
+    while(ended_num < node_num)
+    {
+        if(in_flight.empty())
+            random_wake_up();
+        else
+        {
+            Message q = in_flight.front();
+            in_flight.pop_front();
+
+            tick(q);
+        }
+    }
+}
+
+template<typename Index, typename Weight>
+typename Basic_compact_ghs<Index, Weight>::Graph Basic_compact_ghs<Index, Weight>::get_branches() const
+{
+    Graph result(node_num);
+
+    for(Index v = 0; v < node_num; ++v)
+        for(size_t i = offsets[v]; i < offsets[v + 1]; ++i)
+            if(edge_states[i] == BRANCH)
+                result.add_edge(typename Graph::Edge(v, ends[i], weights[i]));
+
+    result.standartize();
+
+    return result;
+}
+
+template<typename Index, typename Weight>
+size_t Basic_compact_ghs<Index, Weight>::get_message_num() const
+{
+    return message_num;
+}
+
+template<typename Index, typename Weight>
+Basic_graph_as_vector<Index, Weight> compact_ghs(const Basic_graph_as_vector<Index, Weight>& graph)
+{
+    Basic_compact_ghs<Index, Weight> engine(graph);
+    engine.process();
+
+    return engine.get_branches();
+}
+
+extern template class Basic_compact_ghs<size_t, size_t>;
+extern template Graph_as_vector compact_ghs(const Graph_as_vector& graph);
+
+#endif // COMPACT_GHS_H_INCLUDED
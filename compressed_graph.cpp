@@ -0,0 +1,436 @@
+#include <vector>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <cstring>
+#include <cstdint>
+
+#include "compressed_graph.h"
+#include "graph_as_vector.h"
+#include "kruskal.h"
+
+namespace
+{
+
+struct Run_entry
+{
+    size_t node, end, weight;
+};
+
+void put_varint(std::vector<unsigned char>& data, size_t value)
+{
+    for(; value >= 0x80; value >>= 7)
+        data.push_back(static_cast<unsigned char>(value | 0x80));
+    data.push_back(static_cast<unsigned char>(value));
+}
+
+size_t get_varint(const unsigned char*& position)
+{
+    size_t result = *position & 0x7f;
+    for(size_t shift = 7; *position++ & 0x80; shift += 7)
+        result |= static_cast<size_t>(*position & 0x7f) << shift;
+    return result;
+}
+
+unsigned char width_of(size_t weight, bool narrow_weights)
+{
+    if(!narrow_weights || weight > std::numeric_limits<uint32_t>::max())
+        return sizeof(uint64_t);
+    else if(weight > std::numeric_limits<uint16_t>::max())
+        return sizeof(uint32_t);
+    else if(weight > std::numeric_limits<uint8_t>::max())
+        return sizeof(uint16_t);
+    else
+        return sizeof(uint8_t);
+}
+
+template<typename T>
+void put_fixed(std::vector<unsigned char>& data, T value)
+{
+    size_t size = data.size();
+    data.resize(size + sizeof(T));
+    std::memcpy(data.data() + size, &value, sizeof(T));
+}
+
+template<typename T>
+size_t get_fixed(const unsigned char* position)
+{
+    T value;
+    std::memcpy(&value, position, sizeof(T));
+    return value;
+}
+
+class Run_reader
+{
+private:
+    const unsigned char* position, *last_position;
+
+public:
+    Run_entry entry;
+
+    Run_reader(const std::vector<unsigned char>& run) : position(run.data()), last_position(run.data() + run.size()), entry{0, 0, 0} {};
+
+    bool next();
+};
+
+bool Run_reader::next()
+{
+    if(position == last_position)
+        return false;
+
+    size_t node_delta = get_varint(position);
+    entry.node += node_delta;
+    entry.end = node_delta == 0 ? entry.end + get_varint(position) : get_varint(position);
+    entry.weight = get_varint(position);
+
+    return true;
+}
+
+class Run_encoder
+{
+private:
+    std::vector<unsigned char> run;
+    Run_entry previous;
+
+public:
+    Run_encoder() : previous{0, 0, 0} {};
+
+    void push(const Run_entry& entry);
+    std::vector<unsigned char> release();
+};
+
+void Run_encoder::push(const Run_entry& entry)
+{
+    put_varint(run, entry.node - previous.node);
+    put_varint(run, entry.node == previous.node ? entry.end - previous.end : entry.end);
+    put_varint(run, entry.weight);
+    previous = entry;
+}
+
+std::vector<unsigned char> Run_encoder::release()
+{
+    run.shrink_to_fit();
+    return std::move(run);
+}
+
+bool lighter(const Graph_as_vector::Edge& a, const Graph_as_vector::Edge& b)
+{
+    return std::make_tuple(a.get_weight(), a.get_first_node(), a.get_second_node()) < std::make_tuple(b.get_weight(), b.get_first_node(), b.get_second_node());
+}
+
+template<typename Visitor>
+void merge_runs(std::vector<std::vector<unsigned char>>::const_iterator first, std::vector<std::vector<unsigned char>>::const_iterator last, Visitor visit)
+{
+    typedef std::tuple<size_t, size_t, size_t, size_t> Head;
+
+    std::vector<Run_reader> readers(first, last);
+    std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+    for(size_t i = 0; i < readers.size(); ++i)
+        if(readers[i].next())
+            heads.emplace(readers[i].entry.node, readers[i].entry.end, readers[i].entry.weight, i);
+
+    while(!heads.empty())
+    {
+        size_t i = std::get<3>(heads.top());
+        heads.pop();
+
+        visit(readers[i].entry);
+        if(readers[i].next())
+            heads.emplace(readers[i].entry.node, readers[i].entry.end, readers[i].entry.weight, i);
+    }
+}
+
+class Run_writer
+{
+private:
+    size_t node_num, chunk_size;
+    std::vector<Run_entry> entries;
+
+public:
+    std::vector<std::vector<unsigned char>> runs;
+    size_t max_weight;
+
+    Run_writer(size_t node_num, size_t chunk_size) : node_num(node_num), chunk_size(std::max<size_t>(chunk_size, 1)), max_weight(0) {};
+
+    void add(size_t first, size_t second, size_t weight);
+    void flush();
+};
+
+void Run_writer::add(size_t first, size_t second, size_t weight)
+{
+    if(first >= node_num || second >= node_num)
+        throw bad_compressed_graph();
+
+    if(first == second)
+        return;
+
+    max_weight = std::max(max_weight, weight);
+    entries.push_back(Run_entry{std::min(first, second), std::max(first, second), weight});
+
+    if(entries.size() >= chunk_size)
+        flush();
+}
+
+void Run_writer::flush()
+{
+    if(entries.empty())
+        return;
+
+    std::sort(entries.begin(), entries.end(), [](const Run_entry& a, const Run_entry& b)
+    {
+        return std::tie(a.node, a.end, a.weight) < std::tie(b.node, b.end, b.weight);
+    });
+
+    Run_encoder encoder;
+    for(const Run_entry& i : entries)
+        encoder.push(i);
+    runs.push_back(encoder.release());
+
+    entries.clear();
+
+    while(runs.size() >= 2 && runs[runs.size() - 2].size() <= 2 * runs.back().size())
+    {
+        Run_encoder merged;
+        merge_runs(runs.end() - 2, runs.end(), [&merged](const Run_entry& e)
+        {
+            merged.push(e);
+        });
+
+        runs.pop_back();
+        runs.back() = merged.release();
+    }
+}
+
+}
+
+Compressed_graph::Edge_iterator::Edge_iterator(const Compressed_graph& graph, bool at_end) : graph(&graph), position(graph.adjacency.data()), node(0), remaining(0), index(at_end ? graph.edge_num : 0), last(0)
+{
+    if(index < graph.edge_num)
+    {
+        remaining = get_varint(position);
+        advance();
+    }
+}
+
+void Compressed_graph::Edge_iterator::advance()
+{
+    while(remaining == 0)
+    {
+        remaining = get_varint(position);
+        last = ++node;
+    }
+
+    last += get_varint(position);
+    --remaining;
+}
+
+Compressed_graph::Edge Compressed_graph::Edge_iterator::operator*() const
+{
+    return Edge(node, last, graph->get_weight(index));
+}
+
+Compressed_graph::Edge_iterator& Compressed_graph::Edge_iterator::operator++()
+{
+    if(++index < graph->edge_num)
+        advance();
+
+    return *this;
+}
+
+bool Compressed_graph::Edge_iterator::operator==(const Edge_iterator& i) const
+{
+    return index == i.index;
+}
+
+bool Compressed_graph::Edge_iterator::operator!=(const Edge_iterator& i) const
+{
+    return !(*this == i);
+}
+
+Compressed_graph::Compressed_graph(const Graph_as_vector& graph, bool narrow_weights) : node_num(graph.get_node_num()), edge_num(0), weight_width(sizeof(uint64_t))
+{
+    Run_writer writer(node_num, CHUNK_SIZE);
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+        writer.add(graph[i].get_first_node(), graph[i].get_second_node(), graph[i].get_weight());
+    writer.flush();
+
+    build(writer.runs, writer.max_weight, narrow_weights);
+}
+
+Compressed_graph::Compressed_graph(std::istream& stream, bool narrow_weights, size_t chunk_size) : node_num(0), edge_num(0), weight_width(sizeof(uint64_t))
+{
+    size_t stream_edge_num;
+    stream >> node_num >> stream_edge_num;
+    if(!stream)
+        throw bad_compressed_graph();
+
+    Run_writer writer(node_num, chunk_size);
+    for(size_t i = 0; i < stream_edge_num; ++i)
+    {
+        size_t first_node, second_node, weight;
+        stream >> first_node >> second_node >> weight;
+        if(!stream)
+            throw bad_compressed_graph();
+
+        writer.add(first_node, second_node, weight);
+    }
+    writer.flush();
+
+    build(writer.runs, writer.max_weight, narrow_weights);
+}
+
+void Compressed_graph::build(const std::vector<std::vector<unsigned char>>& runs, size_t max_weight, bool narrow_weights)
+{
+    weight_width = width_of(max_weight, narrow_weights);
+
+    std::vector<std::pair<size_t, size_t>> neighbours;
+    size_t node = 0;
+    merge_runs(runs.begin(), runs.end(), [&](const Run_entry& e)
+    {
+        for(; node < e.node; ++node)
+        {
+            append(node, neighbours);
+            neighbours.clear();
+        }
+
+        neighbours.emplace_back(e.end, e.weight);
+        ++edge_num;
+    });
+
+    for(; node < node_num; ++node)
+    {
+        append(node, neighbours);
+        neighbours.clear();
+    }
+
+    adjacency.shrink_to_fit();
+    weights.shrink_to_fit();
+}
+
+void Compressed_graph::append(size_t node, const std::vector<std::pair<size_t, size_t>>& neighbours)
+{
+    put_varint(adjacency, neighbours.size());
+
+    size_t previous = node;
+    for(const std::pair<size_t, size_t>& i : neighbours)
+    {
+        put_varint(adjacency, i.first - previous);
+        previous = i.first;
+
+        switch(weight_width)
+        {
+        case sizeof(uint8_t):
+            put_fixed<uint8_t>(weights, i.second);
+            break;
+        case sizeof(uint16_t):
+            put_fixed<uint16_t>(weights, i.second);
+            break;
+        case sizeof(uint32_t):
+            put_fixed<uint32_t>(weights, i.second);
+            break;
+        default:
+            put_fixed<uint64_t>(weights, i.second);
+        }
+    }
+}
+
+size_t Compressed_graph::get_weight(size_t index) const
+{
+    const unsigned char* position = weights.data() + index * weight_width;
+    switch(weight_width)
+    {
+    case sizeof(uint8_t):
+        return get_fixed<uint8_t>(position);
+    case sizeof(uint16_t):
+        return get_fixed<uint16_t>(position);
+    case sizeof(uint32_t):
+        return get_fixed<uint32_t>(position);
+    default:
+        return get_fixed<uint64_t>(position);
+    }
+}
+
+size_t Compressed_graph::get_node_num() const
+{
+    return node_num;
+}
+
+size_t Compressed_graph::get_edge_num() const
+{
+    return edge_num;
+}
+
+size_t Compressed_graph::get_weight_width() const
+{
+    return weight_width;
+}
+
+size_t Compressed_graph::get_memory() const
+{
+    return sizeof(*this) + adjacency.capacity() + weights.capacity();
+}
+
+Compressed_graph::Edge_iterator Compressed_graph::begin() const
+{
+    return Edge_iterator(*this, false);
+}
+
+Compressed_graph::Edge_iterator Compressed_graph::end() const
+{
+    return Edge_iterator(*this, true);
+}
+
+Graph_as_vector Compressed_graph::decompress() const
+{
+    Graph_as_vector result(node_num, edge_num);
+    for(const Edge& i : *this)
+        result.add_edge(i);
+
+    return result;
+}
+
+Graph_as_vector mst(const Compressed_graph& graph)
+{
+    Dsu dsu;
+    for(size_t i = 0; i < graph.get_node_num(); ++i)
+        dsu.make_set(i);
+
+    std::vector<Graph_as_vector::Edge> cheapest(graph.get_node_num());
+    std::vector<bool> found(graph.get_node_num());
+
+    Graph_as_vector result(graph.get_node_num());
+    for(bool merged = true; merged; )
+    {
+        merged = false;
+        std::fill(found.begin(), found.end(), false);
+
+        for(const Graph_as_vector::Edge& e : graph)
+        {
+            size_t first = dsu.find_set(e.get_first_node()), second = dsu.find_set(e.get_second_node());
+            if(first == second)
+                continue;
+
+            for(size_t i : {first, second})
+                if(!found[i] || lighter(e, cheapest[i]))
+                {
+                    cheapest[i] = e;
+                    found[i] = true;
+                }
+        }
+
+        for(size_t i = 0; i < graph.get_node_num(); ++i)
+            if(found[i] && dsu.find_set(cheapest[i].get_first_node()) != dsu.find_set(cheapest[i].get_second_node()))
+            {
+                result.add_edge(cheapest[i]);
+                dsu.union_sets(cheapest[i].get_first_node(), cheapest[i].get_second_node());
+                merged = true;
+            }
+    }
+
+    result.standartize();
+
+    return result;
+}
@@ -0,0 +1,67 @@
+#ifndef COMPRESSED_GRAPH_H_INCLUDED
+#define COMPRESSED_GRAPH_H_INCLUDED
+
+#include <vector>
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+
+#include "graph_as_vector.h"
+
+class bad_compressed_graph : public std::exception
+{
+};
+
+class Compressed_graph
+{
+public:
+    typedef Graph_as_vector::Edge Edge;
+
+    static constexpr size_t CHUNK_SIZE = size_t(1) << 20;
+
+    class Edge_iterator
+    {
+    private:
+        const Compressed_graph* graph;
+        const unsigned char* position;
+        size_t node, remaining, index, last;
+
+        void advance();
+
+    public:
+        Edge_iterator(const Compressed_graph& graph, bool at_end);
+
+        Edge operator*() const;
+        Edge_iterator& operator++();
+
+        bool operator==(const Edge_iterator& i) const;
+        bool operator!=(const Edge_iterator& i) const;
+    };
+
+private:
+    size_t node_num, edge_num;
+    unsigned char weight_width;
+    std::vector<unsigned char> adjacency, weights;
+
+    void build(const std::vector<std::vector<unsigned char>>& runs, size_t max_weight, bool narrow_weights);
+    void append(size_t node, const std::vector<std::pair<size_t, size_t>>& neighbours);
+    size_t get_weight(size_t index) const;
+
+public:
+    Compressed_graph(const Graph_as_vector& graph, bool narrow_weights = true);
+    Compressed_graph(std::istream& stream, bool narrow_weights = true, size_t chunk_size = CHUNK_SIZE);
+
+    size_t get_node_num() const;
+    size_t get_edge_num() const;
+    size_t get_weight_width() const;
+    size_t get_memory() const;
+
+    Edge_iterator begin() const;
+    Edge_iterator end() const;
+
+    Graph_as_vector decompress() const;
+};
+
+Graph_as_vector mst(const Compressed_graph& graph);
+
+#endif // COMPRESSED_GRAPH_H_INCLUDED
@@ -0,0 +1,8 @@
+#include <cstddef>
+#include <iostream>
+
+#include "dendrogram.h"
+#include "graph_as_vector.h"
+
+template class Basic_dendrogram<size_t, size_t>;
+template std::ostream& operator<<(std::ostream& stream, const Dendrogram& dendrogram);
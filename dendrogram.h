@@ -0,0 +1,133 @@
+#ifndef DENDROGRAM_H_INCLUDED
+#define DENDROGRAM_H_INCLUDED
+
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <limits>
+
+#include "graph_as_vector.h"
+#include "kruskal.h"
+
+template<typename Index, typename Weight>
+class Basic_dendrogram
+{
+public:
+    typedef Basic_graph_as_vector<Index, Weight> Graph;
+
+    struct Merge
+    {
+        Index first_cluster, second_cluster;
+        Weight height;
+        Index size;
+    };
+
+private:
+    static constexpr Index UDEF = std::numeric_limits<Index>::max();
+
+    Index node_num;
+    std::vector<Merge> merges;
+
+    std::vector<Index> labels(size_t merge_num) const;
+
+public:
+    Basic_dendrogram(const Graph& graph, size_t thread_num = 1);
+
+    Index get_node_num() const;
+    const std::vector<Merge>& get_merges() const;
+
+    std::vector<Index> cut(size_t cluster_num) const;
+    std::vector<Index> cut_at(Weight height) const;
+};
+
+typedef Basic_dendrogram<size_t, size_t> Dendrogram;
+
+template<typename Index, typename Weight>
+std::ostream& operator<<(std::ostream& stream, const Basic_dendrogram<Index, Weight>& dendrogram);
+
+template<typename Index, typename Weight>
+Basic_dendrogram<Index, Weight>::Basic_dendrogram(const Graph& graph, size_t thread_num) : node_num(graph.get_node_num())
+{
+    std::vector<Index> clusters(node_num), sizes(node_num, 1);
+    for(Index i = 0; i < node_num; ++i)
+        clusters[i] = i;
+
+    merges.reserve(node_num > 0 ? node_num - 1 : 0);
+    kruskal_sweep(graph, [this, &clusters, &sizes](const typename Graph::Edge& edge, Index first, Index second, Index root)
+    {
+        merges.push_back(Merge{clusters[first], clusters[second], edge.get_weight(), static_cast<Index>(sizes[first] + sizes[second])});
+
+        clusters[root] = node_num + merges.size() - 1;
+        sizes[root] = merges.back().size;
+    }, thread_num);
+}
+
+template<typename Index, typename Weight>
+Index Basic_dendrogram<Index, Weight>::get_node_num() const
+{
+    return node_num;
+}
+
+template<typename Index, typename Weight>
+const std::vector<typename Basic_dendrogram<Index, Weight>::Merge>& Basic_dendrogram<Index, Weight>::get_merges() const
+{
+    return merges;
+}
+
+template<typename Index, typename Weight>
+std::vector<Index> Basic_dendrogram<Index, Weight>::labels(size_t merge_num) const
+{
+    std::vector<Index> representatives(node_num + merge_num);
+    for(Index i = 0; i < node_num; ++i)
+        representatives[i] = i;
+
+    Basic_dsu<Index> dsu;
+    for(Index i = 0; i < node_num; ++i)
+        dsu.make_set(i);
+
+    for(size_t i = 0; i < merge_num; ++i)
+    {
+        representatives[node_num + i] = representatives[merges[i].first_cluster];
+        dsu.union_sets(representatives[merges[i].first_cluster], representatives[merges[i].second_cluster]);
+    }
+
+    std::vector<Index> result(node_num), roots(node_num, UDEF);
+    Index label_num = 0;
+    for(Index i = 0; i < node_num; ++i)
+    {
+        Index root = dsu.find_set(i);
+        if(roots[root] == UDEF)
+            roots[root] = label_num++;
+        result[i] = roots[root];
+    }
+
+    return result;
+}
+
+template<typename Index, typename Weight>
+std::vector<Index> Basic_dendrogram<Index, Weight>::cut(size_t cluster_num) const
+{
+    return labels(cluster_num < node_num ? std::min<size_t>(merges.size(), node_num - cluster_num) : 0);
+}
+
+template<typename Index, typename Weight>
+std::vector<Index> Basic_dendrogram<Index, Weight>::cut_at(Weight height) const
+{
+    return labels(std::distance(merges.begin(), std::upper_bound(merges.begin(), merges.end(), height, [](Weight h, const Merge& m)
+    {
+        return h < m.height;
+    })));
+}
+
+template<typename Index, typename Weight>
+std::ostream& operator<<(std::ostream& stream, const Basic_dendrogram<Index, Weight>& dendrogram)
+{
+    for(const typename Basic_dendrogram<Index, Weight>::Merge& i : dendrogram.get_merges())
+        stream << i.first_cluster << " " << i.second_cluster << " " << i.height << " " << i.size << std::endl;
+    return stream;
+}
+
+extern template class Basic_dendrogram<size_t, size_t>;
+extern template std::ostream& operator<<(std::ostream& stream, const Dendrogram& dendrogram);
+
+#endif // DENDROGRAM_H_INCLUDED
@@ -0,0 +1,299 @@
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "dynamic_mst.h"
+#include "graph_as_vector.h"
+#include "link_cut_tree.h"
+#include "kruskal.h"
+
+Dynamic_mst::Dynamic_mst(const Graph_as_vector& graph) : node_num(graph.get_node_num())
+{
+    seed(graph);
+}
+
+void Dynamic_mst::seed(const Graph_as_vector& graph)
+{
+    forest = Link_cut_tree(node_num);
+    edges.clear();
+    in_tree.clear();
+    free_slots.clear();
+    slots.clear();
+    tree_incident.assign(node_num, std::unordered_set<size_t>());
+    non_tree_incident.assign(node_num, std::unordered_set<size_t>());
+
+    Graph_as_vector tree = mst(graph);
+    std::unordered_set<Graph_as_vector::Primitive_edge> tree_edges;
+    for(size_t i = 0; i < tree.get_edge_num(); ++i)
+        tree_edges.insert(tree[i]);
+
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+    {
+        size_t slot = allocate(graph[i]);
+        if(tree_edges.erase(edges[slot]))
+            link(slot);
+        else
+            park(slot);
+    }
+}
+
+size_t Dynamic_mst::find_slot(Graph_as_vector::Primitive_edge edge) const
+{
+    std::unordered_map<Graph_as_vector::Primitive_edge, size_t>::const_iterator i = slots.find(edge.standartize());
+    if(i == slots.end())
+        throw dynamic_mst_misuse();
+    return i->second;
+}
+
+size_t Dynamic_mst::allocate(const Graph_as_vector::Edge& edge_)
+{
+    Graph_as_vector::Edge edge = edge_;
+    edge.standartize();
+
+    if(edge.get_second_node() >= node_num || slots.count(edge))
+        throw dynamic_mst_misuse();
+
+    size_t slot;
+    if(free_slots.empty())
+    {
+        slot = edges.size();
+        edges.push_back(edge);
+        in_tree.push_back(false);
+        forest.add_vertex();
+    }
+    else
+    {
+        slot = free_slots.back();
+        free_slots.pop_back();
+        edges[slot] = edge;
+    }
+
+    slots[edge] = slot;
+    return slot;
+}
+
+void Dynamic_mst::release(size_t slot)
+{
+    slots.erase(edges[slot]);
+    free_slots.push_back(slot);
+}
+
+size_t Dynamic_mst::get_end(size_t slot, size_t node) const
+{
+    return edges[slot].get_first_node() == node ? edges[slot].get_second_node() : edges[slot].get_first_node();
+}
+
+void Dynamic_mst::link(size_t slot)
+{
+    size_t v = node_num + slot;
+    forest.set_weight(v, edges[slot].get_weight());
+    forest.link(edges[slot].get_first_node(), v);
+    forest.link(v, edges[slot].get_second_node());
+    tree_incident[edges[slot].get_first_node()].insert(slot);
+    tree_incident[edges[slot].get_second_node()].insert(slot);
+    in_tree[slot] = true;
+}
+
+void Dynamic_mst::cut(size_t slot)
+{
+    size_t v = node_num + slot;
+    forest.cut(edges[slot].get_first_node(), v);
+    forest.cut(v, edges[slot].get_second_node());
+    tree_incident[edges[slot].get_first_node()].erase(slot);
+    tree_incident[edges[slot].get_second_node()].erase(slot);
+    in_tree[slot] = false;
+}
+
+void Dynamic_mst::park(size_t slot)
+{
+    non_tree_incident[edges[slot].get_first_node()].insert(slot);
+    non_tree_incident[edges[slot].get_second_node()].insert(slot);
+}
+
+void Dynamic_mst::unpark(size_t slot)
+{
+    non_tree_incident[edges[slot].get_first_node()].erase(slot);
+    non_tree_incident[edges[slot].get_second_node()].erase(slot);
+}
+
+bool Dynamic_mst::explore(std::vector<std::pair<size_t, std::unordered_set<size_t>::const_iterator>>& stack, std::unordered_set<size_t>& side) const
+{
+    while(!stack.empty() && stack.back().second == tree_incident[stack.back().first].end())
+        stack.pop_back();
+
+    if(stack.empty())
+        return false;
+
+    size_t end = get_end(*stack.back().second++, stack.back().first);
+    if(side.insert(end).second)
+        stack.push_back(std::make_pair(end, tree_incident[end].begin()));
+
+    return true;
+}
+
+void Dynamic_mst::place(size_t slot)
+{
+    size_t a = edges[slot].get_first_node(), b = edges[slot].get_second_node();
+
+    if(a != b && !forest.connected(a, b))
+    {
+        link(slot);
+        return;
+    }
+
+    if(a != b)
+    {
+        size_t heaviest = forest.path_max(a, b) - node_num;
+        if(std::make_pair(edges[slot].get_weight(), slot) < std::make_pair(edges[heaviest].get_weight(), heaviest))
+        {
+            cut(heaviest);
+            link(slot);
+            park(heaviest);
+            return;
+        }
+    }
+
+    park(slot);
+}
+
+void Dynamic_mst::replace(size_t slot)
+{
+    cut(slot);
+
+    std::vector<std::pair<size_t, std::unordered_set<size_t>::const_iterator>> stacks[2];
+    std::unordered_set<size_t> sides[2];
+    size_t ends[2] = {edges[slot].get_first_node(), edges[slot].get_second_node()}, smaller = 0;
+    for(size_t i = 0; i < 2; ++i)
+    {
+        sides[i].insert(ends[i]);
+        stacks[i].push_back(std::make_pair(ends[i], tree_incident[ends[i]].begin()));
+    }
+
+    while(true)
+    {
+        if(!explore(stacks[0], sides[0]))
+            break;
+        if(!explore(stacks[1], sides[1]))
+        {
+            smaller = 1;
+            break;
+        }
+    }
+
+    size_t best = edges.size();
+    for(size_t v : sides[smaller])
+        for(size_t i : non_tree_incident[v])
+            if(!sides[smaller].count(get_end(i, v)) && (best == edges.size() || std::make_pair(edges[i].get_weight(), i) < std::make_pair(edges[best].get_weight(), best)))
+                best = i;
+
+    if(best != edges.size())
+    {
+        unpark(best);
+        link(best);
+    }
+}
+
+void Dynamic_mst::insert_edge(const Graph_as_vector::Edge& edge)
+{
+    place(allocate(edge));
+}
+
+void Dynamic_mst::delete_edge(const Graph_as_vector::Primitive_edge& edge)
+{
+    size_t slot = find_slot(edge);
+
+    if(in_tree[slot])
+        replace(slot);
+    else
+        unpark(slot);
+
+    release(slot);
+}
+
+void Dynamic_mst::change_weight(const Graph_as_vector::Primitive_edge& edge, size_t weight)
+{
+    size_t slot = find_slot(edge);
+    size_t old_weight = edges[slot].get_weight();
+
+    edges[slot] = Graph_as_vector::Edge(edges[slot].get_first_node(), edges[slot].get_second_node(), weight);
+
+    if(in_tree[slot])
+    {
+        forest.set_weight(node_num + slot, weight);
+        if(weight > old_weight)
+        {
+            park(slot);
+            replace(slot);
+        }
+    }
+    else
+    {
+        unpark(slot);
+        place(slot);
+    }
+}
+
+void Dynamic_mst::update(const std::vector<Update>& updates)
+{
+    std::unordered_map<Graph_as_vector::Primitive_edge, std::pair<bool, size_t>> net;
+
+    for(const Update& i : updates)
+    {
+        Graph_as_vector::Primitive_edge key = i.edge;
+        key.standartize();
+
+        std::unordered_map<Graph_as_vector::Primitive_edge, std::pair<bool, size_t>>::const_iterator j = net.find(key);
+        bool present = j != net.end() ? j->second.first : slots.count(key) != 0;
+
+        if(present == (i.type == Update::INSERT))
+            throw dynamic_mst_misuse();
+
+        net[key] = std::make_pair(i.type != Update::DELETE, i.edge.get_weight());
+    }
+
+    size_t edge_num = slots.size(), log_edge_num = 1;
+    while((size_t(1) << log_edge_num) < edge_num)
+        ++log_edge_num;
+
+    if(net.size() * log_edge_num > edge_num)
+    {
+        Graph_as_vector graph(node_num, edge_num + net.size());
+        for(const std::pair<const Graph_as_vector::Primitive_edge, size_t>& i : slots)
+            if(!net.count(i.first))
+                graph.add_edge(edges[i.second]);
+        for(const std::pair<const Graph_as_vector::Primitive_edge, std::pair<bool, size_t>>& i : net)
+            if(i.second.first)
+                graph.add_edge(Graph_as_vector::Edge(i.first.get_first_node(), i.first.get_second_node(), i.second.second));
+
+        seed(graph);
+        return;
+    }
+
+    for(const std::pair<const Graph_as_vector::Primitive_edge, std::pair<bool, size_t>>& i : net)
+    {
+        bool present = slots.count(i.first) != 0;
+        if(present && i.second.first)
+        {
+            if(edges[slots[i.first]].get_weight() != i.second.second)
+                change_weight(i.first, i.second.second);
+        }
+        else if(present)
+            delete_edge(i.first);
+        else if(i.second.first)
+            insert_edge(Graph_as_vector::Edge(i.first.get_first_node(), i.first.get_second_node(), i.second.second));
+    }
+}
+
+Graph_as_vector Dynamic_mst::get_forest() const
+{
+    Graph_as_vector result(node_num);
+
+    for(size_t i = 0; i < edges.size(); ++i)
+        if(in_tree[i])
+            result.add_edge(edges[i]);
+
+    result.standartize();
+
+    return result;
+}
@@ -0,0 +1,64 @@
+#ifndef DYNAMIC_MST_H_INCLUDED
+#define DYNAMIC_MST_H_INCLUDED
+
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <stdexcept>
+
+#include "graph_as_vector.h"
+#include "link_cut_tree.h"
+
+class dynamic_mst_misuse : public std::exception
+{
+};
+
+class Dynamic_mst
+{
+public:
+    struct Update
+    {
+        enum Type {INSERT, DELETE, CHANGE_WEIGHT};
+
+        Type type;
+        Graph_as_vector::Edge edge;
+    };
+
+private:
+    size_t node_num;
+    Link_cut_tree forest;
+
+    std::vector<Graph_as_vector::Edge> edges;
+    std::vector<bool> in_tree;
+    std::vector<size_t> free_slots;
+    std::unordered_map<Graph_as_vector::Primitive_edge, size_t> slots;
+    std::vector<std::unordered_set<size_t>> tree_incident, non_tree_incident;
+
+    void seed(const Graph_as_vector& graph);
+    size_t find_slot(Graph_as_vector::Primitive_edge edge) const;
+    size_t allocate(const Graph_as_vector::Edge& edge);
+    void release(size_t slot);
+
+    size_t get_end(size_t slot, size_t node) const;
+    void link(size_t slot);
+    void cut(size_t slot);
+    void park(size_t slot);
+    void unpark(size_t slot);
+    bool explore(std::vector<std::pair<size_t, std::unordered_set<size_t>::const_iterator>>& stack, std::unordered_set<size_t>& side) const;
+    void place(size_t slot);
+    // expected O(k + log n), k being the smaller side of the cut plus its incident non-tree edges
+    void replace(size_t slot);
+
+public:
+    Dynamic_mst(const Graph_as_vector& graph);
+
+    void insert_edge(const Graph_as_vector::Edge& edge);
+    void delete_edge(const Graph_as_vector::Primitive_edge& edge);
+    void change_weight(const Graph_as_vector::Primitive_edge& edge, size_t weight);
+    void update(const std::vector<Update>& updates);
+
+    Graph_as_vector get_forest() const;
+};
+
+#endif // DYNAMIC_MST_H_INCLUDED
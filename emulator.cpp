@@ -2,9 +2,18 @@
 #include <deque>
 #include <memory>
 #include <algorithm>
+#include <unordered_map>
+#include <map>
+#include <functional>
+#include <iostream>
 
 #include "emulator.h"
+#include "mailbox.h"
+#include "random.h"
 #include "graph_as_vector.h"
+#include "compressed_graph.h"
+#include "trace.h"
+#include "scheduler.h"
 
 size_t Emulator_query::get_sender() const
 {
@@ -16,70 +25,410 @@ size_t Emulator_query::get_recipient() const
     return recipient;
 }
 
+unsigned char Emulator_query::get_type() const
+{
+    return 0;
+}
+
+const char* Emulator_query::get_name() const
+{
+    return "QUERY";
+}
+
+size_t Emulator_query::get_payload(size_t i) const
+{
+    return 0;
+}
+
+const std::vector<size_t>& Emulator_multicast::get_recipients() const
+{
+    return recipients;
+}
+
+const std::shared_ptr<const Emulator_query>& Emulator_multicast::get_query() const
+{
+    return query;
+}
+
+void Emulator_node::set_node_num(size_t node_num)
+{
+}
+
+unsigned char Emulator_node::get_state() const
+{
+    return 0;
+}
+
+size_t Emulator_node::get_priority() const
+{
+    return 0;
+}
+
+size_t Emulator_node::get_fragment() const
+{
+    return NO_FRAGMENT;
+}
+
+size_t Emulator_node::get_signature() const
+{
+    return mix_signature(mix_signature(get_state(), get_priority()), get_fragment());
+}
+
+Link_clocks::Link_clocks(const Graph_as_vector& graph) : offsets(graph.get_node_num() + 1, 0)
+{
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+    {
+        ++offsets[graph[i].get_first_node() + 1];
+        ++offsets[graph[i].get_second_node() + 1];
+    }
+    for(size_t i = 0; i < graph.get_node_num(); ++i)
+        offsets[i + 1] += offsets[i];
+
+    std::vector<size_t> filled(offsets.begin(), offsets.end() - 1);
+    ends.resize(offsets.back());
+    last.resize(offsets.back(), 0);
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+    {
+        ends[filled[graph[i].get_first_node()]++] = graph[i].get_second_node();
+        ends[filled[graph[i].get_second_node()]++] = graph[i].get_first_node();
+    }
+
+    for(size_t i = 0; i < graph.get_node_num(); ++i)
+        std::sort(ends.begin() + offsets[i], ends.begin() + offsets[i + 1]);
+}
+
+Link_clocks::Link_clocks(const Compressed_graph& graph) : offsets(graph.get_node_num() + 1, 0)
+{
+    for(const Compressed_graph::Edge& i : graph)
+    {
+        ++offsets[i.get_first_node() + 1];
+        ++offsets[i.get_second_node() + 1];
+    }
+    for(size_t i = 0; i < graph.get_node_num(); ++i)
+        offsets[i + 1] += offsets[i];
+
+    std::vector<size_t> filled(offsets.begin(), offsets.end() - 1);
+    ends.resize(offsets.back());
+    last.resize(offsets.back(), 0);
+    for(const Compressed_graph::Edge& i : graph)
+    {
+        ends[filled[i.get_first_node()]++] = i.get_second_node();
+        ends[filled[i.get_second_node()]++] = i.get_first_node();
+    }
+}
+
+size_t& Link_clocks::operator()(size_t sender, size_t recipient)
+{
+    if(sender + 1 >= offsets.size())
+        throw bad_ghs();
+
+    std::vector<size_t>::const_iterator first = ends.begin() + offsets[sender], last_ = ends.begin() + offsets[sender + 1];
+    std::vector<size_t>::const_iterator i = std::lower_bound(first, last_, recipient);
+    if(i == last_ || *i != recipient)
+        throw bad_ghs();
+
+    return last[i - ends.begin()];
+}
+
 const std::shared_ptr<Emulator_node>& Emulator::operator[](size_t i)
 {
     return nodes[i];
 }
 
+Emulator_progress Emulator::get_progress() const
+{
+    return Emulator_progress{round_num, message_num, ended_num, loose_num + fragment_sizes.size(), level_sizes.empty() ? 0 : level_sizes.rbegin()->first};
+}
+
+size_t Emulator::get_round_num() const
+{
+    return round_num;
+}
+
+size_t Emulator::get_message_num() const
+{
+    return message_num;
+}
+
+size_t Emulator::get_time() const
+{
+    return time;
+}
+
+void Emulator::send(const std::shared_ptr<const Emulator_query>& q, size_t recipient)
+{
+    size_t sender = q->get_sender();
+
+    size_t& last = links(sender, recipient);
+    last = std::max(last, clocks[sender]) + 1;
+
+    box.push_back(recipient, q);
+    stamps.push_back(recipient, last);
+    schedule(recipient);
+    ++message_num;
+}
+
 void Emulator::process_queries(const std::deque<std::shared_ptr<const Emulator_query>>& queries)
 {
-    for(typename std::deque<std::shared_ptr<const Emulator_query>>::const_iterator i = queries.begin(); i != queries.end(); ++i)
+    for(const std::shared_ptr<const Emulator_query>& i : queries)
+        if(i->get_recipient() != Emulator_query::MULTICAST)
+            send(i, i->get_recipient());
+        else
+        {
+            const Emulator_multicast& multicast = static_cast<const Emulator_multicast&>(*i);
+            for(size_t j : multicast.get_recipients())
+                send(multicast.get_query(), j);
+        }
+}
+
+void Emulator::post(std::shared_ptr<const Emulator_query> q)
+{
+    process_queries(std::deque<std::shared_ptr<const Emulator_query>>(1, q));
+}
+
+void Emulator::set_trace(Trace_writer* trace_)
+{
+    trace = trace_;
+}
+
+void Emulator::set_scheduler(std::shared_ptr<Scheduler> scheduler_)
+{
+    scheduler = scheduler_;
+
+    for(size_t i = 0; i < nodes.size(); ++i)
     {
-        if(graph.find(Graph_as_vector::Primitive_edge((*i)->get_sender(), (*i)->get_recipient()).standartize()) != graph.end())
-            box[(*i)->get_recipient()].push_back(*i);
+        scheduled[i] = false;
+        if(!box.empty(i))
+            schedule(i);
+    }
+}
+
+void Emulator::set_progress(std::function<void(const Emulator_progress&)> callback, size_t interval)
+{
+    progress_callback = std::move(callback);
+    progress_interval = progress_callback ? interval : 0;
+}
+
+void Emulator::set_livelock_rounds(size_t rounds)
+{
+    livelock_rounds = rounds;
+    quiet_rounds = 0;
+    changed = false;
+}
+
+void Emulator::check_progress()
+{
+    if(livelock_rounds != 0)
+    {
+        quiet_rounds = changed ? 0 : quiet_rounds + 1;
+        changed = false;
+
+        if(quiet_rounds >= livelock_rounds)
+        {
+            std::vector<size_t> busy;
+            for(size_t i = 0; i < nodes.size(); ++i)
+                if(!box.empty(i))
+                    busy.push_back(i);
+
+            throw bad_livelock(get_progress(), std::move(busy));
+        }
+    }
+
+    if(progress_interval != 0 && round_num % progress_interval == 0)
+        progress_callback(get_progress());
+}
+
+void Emulator::schedule(size_t i)
+{
+    if(!scheduled[i])
+    {
+        scheduled[i] = true;
+        scheduler->ready(i, nodes[i]->get_priority());
+    }
+}
+
+void Emulator::update_ended(size_t i)
+{
+    if(!ended[i] && nodes[i]->ended())
+    {
+        ended[i] = true;
+        ++ended_num;
+    }
+}
+
+void Emulator::track(size_t i)
+{
+    size_t fragment = nodes[i]->get_fragment(), level = nodes[i]->get_priority();
+
+    if(fragment != fragments[i])
+    {
+        if(fragments[i] == Emulator_node::NO_FRAGMENT)
+            --loose_num;
+        else if(--fragment_sizes[fragments[i]] == 0)
+            fragment_sizes.erase(fragments[i]);
+
+        if(fragment == Emulator_node::NO_FRAGMENT)
+            ++loose_num;
         else
-            throw bad_ghs();
+            ++fragment_sizes[fragment];
+
+        fragments[i] = fragment;
+    }
+
+    if(level != levels[i])
+    {
+        if(--level_sizes[levels[i]] == 0)
+            level_sizes.erase(levels[i]);
+        ++level_sizes[level];
+
+        levels[i] = level;
     }
 }
 
+void Emulator::wake_up(size_t i)
+{
+    awake[i] = true;
+    changed = true;
+
+    if(!trace)
+    {
+        process_queries(nodes[i]->wake_up());
+        update_ended(i);
+        track(i);
+        return;
+    }
+
+    unsigned char state = nodes[i]->get_state();
+    const std::deque<std::shared_ptr<const Emulator_query>>& queries = nodes[i]->wake_up();
+    trace->wake_up(round_num, i, state, nodes[i]->get_state());
+    process_queries(queries);
+    update_ended(i);
+    track(i);
+}
+
+void Emulator::deliver(size_t i)
+{
+    std::shared_ptr<const Emulator_query> q = box.front(i);
+    box.pop_front(i);
+    awake[i] = true;
+
+    clocks[i] = std::max(clocks[i], stamps.front(i));
+    time = std::max(time, clocks[i]);
+    stamps.pop_front(i);
+
+    size_t signature = livelock_rounds != 0 ? nodes[i]->get_signature() : 0;
+
+    if(!trace)
+        process_queries(nodes[i]->tick(q));
+    else
+    {
+        unsigned char state = nodes[i]->get_state();
+        const std::deque<std::shared_ptr<const Emulator_query>>& queries = nodes[i]->tick(q);
+        trace->deliver(round_num, q->get_sender(), i, q->get_type(), q->get_name(), q->get_payload(0), q->get_payload(1), state, nodes[i]->get_state());
+        process_queries(queries);
+    }
+
+    if(livelock_rounds != 0 && nodes[i]->get_signature() != signature)
+        changed = true;
+
+    update_ended(i);
+    track(i);
+    if(!box.empty(i))
+        schedule(i);
+}
+
 void Emulator::random_wake_up()
 {
-    size_t num = rnd(1, nodes.size());
-    for(size_t i = 0; i < num; ++i)
+    if(sleeping.empty())
+        throw bad_ghs();
+
+    for(size_t num = random(1, sleeping.size()); num > 0 && !sleeping.empty(); )
     {
-        size_t rnode = rnd(0, nodes.size() - 1);
-        process_queries(nodes[rnode]->wake_up());
+        size_t j = random(0, sleeping.size() - 1), i = sleeping[j];
+        sleeping[j] = sleeping.back();
+        sleeping.pop_back();
+
+        if(!awake[i])
+        {
+            wake_up(i);
+            --num;
+        }
     }
 }
 
 void Emulator::process()
 {
-    bool go = true, all_boxes_empty = true;
-
-    std::vector<size_t> indexes(box.size());
-    for(size_t i = 0; i < indexes.size(); i++)
-        indexes[i] = i;
+    sleeping.clear();
+    for(size_t i = 0; i < nodes.size(); ++i)
+    {
+        update_ended(i);
+        track(i);
+        if(!ended[i] && !awake[i])
+            sleeping.push_back(i);
+    }
 
-    while(go)
+    std::vector<size_t> round;
+    while(ended_num < nodes.size())
     {
-        if(all_boxes_empty)
+        if(scheduler->empty())
             random_wake_up();
-        else
-            all_boxes_empty = true;
 
-        std::random_shuffle(indexes.begin(), indexes.end());
-        size_t box_num = rnd(1, box.size());
+        ++round_num;
 
-        for(std::vector<size_t>::iterator i = indexes.begin(); i != indexes.begin() + box_num; ++i)
-        {
-            if(box[*i].empty())
-                continue;
+        scheduler->select(round, random);
+        for(size_t i : round)
+            scheduled[i] = false;
 
-            std::shared_ptr<const Emulator_query> q = box[*i].front();
-            box[*i].pop_front();
+        for(size_t i : round)
+            if(!box.empty(i))
+                deliver(i);
 
-            process_queries(nodes[*i]->tick(q));
-        }
+        check_progress();
+    }
+
+    if(progress_interval != 0)
+        progress_callback(get_progress());
+}
+
+void Emulator::replay(Trace_reader& reader)
+{
+    if(reader.get_node_num() != nodes.size())
+        throw bad_trace();
+
+    for(size_t i = 0; i < nodes.size(); ++i)
+        track(i);
 
-        for(const std::deque<std::shared_ptr<const Emulator_query>>& i : box)
-            if(!i.empty())
-            {
-                all_boxes_empty = false;
-                break;
-            }
+    Trace_record record;
+    while(reader.next(record))
+    {
+        if(record.recipient >= nodes.size())
+            throw bad_trace();
+
+        round_num = record.round;
 
-        go = false;
-        for(const std::shared_ptr<Emulator_node>& i : nodes)
-            go = go || !i->ended();
+        if(record.kind == Trace_record::WAKE_UP)
+            wake_up(record.recipient);
+        else if(!box.empty(record.recipient) && box.front(record.recipient)->get_sender() == record.sender && box.front(record.recipient)->get_type() == record.type)
+            deliver(record.recipient);
+        else
+            throw bad_trace();
     }
+
+    for(const std::shared_ptr<Emulator_node>& i : nodes)
+        if(!i->ended())
+            throw bad_trace();
+}
+
+size_t mix_signature(size_t signature, size_t value)
+{
+    return signature * 0x9E3779B97F4A7C15ull ^ (value + (signature << 6) + (signature >> 2));
+}
+
+std::ostream& operator<<(std::ostream& stream, const Emulator_progress& progress)
+{
+    return stream << "round " << progress.round_num
+                  << ", messages " << progress.message_num
+                  << ", ended " << progress.ended_num
+                  << ", fragments " << progress.fragment_num
+                  << ", level " << progress.max_level;
 }
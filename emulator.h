@@ -6,17 +6,44 @@
 #include <memory>
 #include <algorithm>
 #include <unordered_set>
+#include <unordered_map>
+#include <map>
+#include <utility>
 #include <stdexcept>
+#include <limits>
+#include <functional>
+#include <iostream>
 
 #include "graph_as_vector.h"
+#include "compressed_graph.h"
+#include "mailbox.h"
 #include "random.h"
+#include "trace.h"
+#include "scheduler.h"
 
 class bad_ghs : public std::exception
 {
 };
 
+struct Emulator_progress
+{
+    size_t round_num, message_num, ended_num, fragment_num, max_level;
+};
+
+class bad_livelock : public bad_ghs
+{
+public:
+    Emulator_progress progress;
+    std::vector<size_t> busy;
+
+    bad_livelock(const Emulator_progress& progress, std::vector<size_t> busy) : progress(progress), busy(std::move(busy)) {};
+};
+
 class Emulator_query
 {
+public:
+    static constexpr size_t MULTICAST = std::numeric_limits<size_t>::max();
+
 private:
     size_t sender, recipient;
 
@@ -26,20 +53,56 @@ public:
     size_t get_sender() const;
     size_t get_recipient() const;
 
+    virtual unsigned char get_type() const;
+    virtual const char* get_name() const;
+    virtual size_t get_payload(size_t i) const;
+
     virtual ~Emulator_query() = default;
 };
 
+class Emulator_multicast : public Emulator_query
+{
+private:
+    std::vector<size_t> recipients;
+    std::shared_ptr<const Emulator_query> query;
+
+public:
+    Emulator_multicast(std::vector<size_t> recipients, std::shared_ptr<const Emulator_query> query) : Emulator_query(query->get_sender(), MULTICAST), recipients(std::move(recipients)), query(std::move(query)) {};
+
+    const std::vector<size_t>& get_recipients() const;
+    const std::shared_ptr<const Emulator_query>& get_query() const;
+};
+
 class Emulator_node
 {
 public:
+    static constexpr size_t NO_FRAGMENT = std::numeric_limits<size_t>::max();
+
     virtual void set_id(size_t id) = 0;
+    virtual void set_node_num(size_t node_num);
     virtual const std::deque<std::shared_ptr<const Emulator_query>>& tick(std::shared_ptr<const Emulator_query> q) = 0;
     virtual void add_edge(size_t end, size_t weight) = 0;
     virtual const std::deque<std::shared_ptr<const Emulator_query>>& wake_up() = 0;
     virtual bool ended() const = 0;
+    virtual unsigned char get_state() const;
+    virtual size_t get_priority() const;
+    virtual size_t get_fragment() const;
+    virtual size_t get_signature() const;
     virtual ~Emulator_node() = default;
 };
 
+class Link_clocks
+{
+private:
+    std::vector<size_t> offsets, ends, last;
+
+public:
+    Link_clocks(const Graph_as_vector& graph);
+    Link_clocks(const Compressed_graph& graph);
+
+    size_t& operator()(size_t sender, size_t recipient);
+};
+
 template<typename T>
 struct Identity
 {
@@ -49,38 +112,86 @@ struct Identity
 class Emulator
 {
 private:
-    std::vector<std::deque<std::shared_ptr<const Emulator_query>>> box;
+    Mailbox<std::shared_ptr<const Emulator_query>> box;
+    Mailbox<size_t> stamps;
     std::vector<std::shared_ptr<Emulator_node>> nodes;
-    std::unordered_set<Graph_as_vector::Primitive_edge> graph;
+    Link_clocks links;
+    std::vector<size_t> clocks;
+    Random random;
+    size_t round_num, message_num, ended_num, time;
+    Trace_writer* trace;
+    std::shared_ptr<Scheduler> scheduler;
+    std::vector<bool> scheduled, awake, ended;
+    std::vector<size_t> sleeping, fragments, levels;
+    std::unordered_map<size_t, size_t> fragment_sizes;
+    std::map<size_t, size_t> level_sizes;
+    size_t loose_num;
+    std::function<void(const Emulator_progress&)> progress_callback;
+    size_t progress_interval, livelock_rounds, quiet_rounds;
+    bool changed;
 
     template<typename Id>
-    Emulator(const Graph_as_vector& graph, Id obj);
+    Emulator(size_t node_num, Link_clocks links, size_t seed, Id obj);
+    template<typename Id>
+    Emulator(const Graph_as_vector& graph, size_t seed, Id obj);
+    template<typename Id>
+    Emulator(const Compressed_graph& graph, size_t seed, Id obj);
 
+    void schedule(size_t i);
+    void update_ended(size_t i);
+    void track(size_t i);
+    void wake_up(size_t i);
+    void deliver(size_t i);
     void random_wake_up();
+    void send(const std::shared_ptr<const Emulator_query>& q, size_t recipient);
     void process_queries(const std::deque<std::shared_ptr<const Emulator_query>>& queries);
+    void check_progress();
 
 public:
     template<typename Node>
     static Emulator create(const Graph_as_vector& graph);
+    template<typename Node>
+    static Emulator create(const Graph_as_vector& graph, size_t seed);
+    template<typename Node>
+    static Emulator create(const Compressed_graph& graph);
+    template<typename Node>
+    static Emulator create(const Compressed_graph& graph, size_t seed);
 
     const std::shared_ptr<Emulator_node>& operator[](size_t i);
 
+    void post(std::shared_ptr<const Emulator_query> q);
     void process();
+    void replay(Trace_reader& reader);
+    void set_trace(Trace_writer* trace_);
+    void set_scheduler(std::shared_ptr<Scheduler> scheduler_);
+    void set_progress(std::function<void(const Emulator_progress&)> callback, size_t interval);
+    void set_livelock_rounds(size_t rounds);
+
+    Emulator_progress get_progress() const;
+    size_t get_round_num() const;
+    size_t get_message_num() const;
+    size_t get_time() const;
 };
 
 template<typename Id>
-Emulator::Emulator(const Graph_as_vector& graph_, Id obj) : box(graph_.get_node_num())
+Emulator::Emulator(size_t node_num, Link_clocks links_, size_t seed, Id obj) : box(node_num), stamps(node_num), links(std::move(links_)), clocks(node_num, 0), random(seed), round_num(0), message_num(0), ended_num(0), time(0), trace(nullptr), scheduler(std::make_shared<Random_scheduler>()),
+    scheduled(node_num, false), awake(node_num, false), ended(node_num, false), fragments(node_num, Emulator_node::NO_FRAGMENT), levels(node_num, 0), loose_num(node_num), progress_interval(0), livelock_rounds(0), quiet_rounds(0), changed(false)
 {
-    for(size_t i = 0; i < graph_.get_edge_num(); ++i)
-        graph.insert(Graph_as_vector::Primitive_edge(graph_[i]).standartize());
-
-    nodes.reserve(graph_.get_node_num());
-    for(size_t i = 0; i < graph_.get_node_num(); ++i)
+    nodes.reserve(node_num);
+    for(size_t i = 0; i < node_num; ++i)
     {
         nodes.push_back(std::shared_ptr<Emulator_node>(new typename Id::type));
         nodes.back()->set_id(i);
+        nodes.back()->set_node_num(node_num);
     }
 
+    if(node_num > 0)
+        level_sizes[0] = node_num;
+}
+
+template<typename Id>
+Emulator::Emulator(const Graph_as_vector& graph_, size_t seed, Id obj) : Emulator(graph_.get_node_num(), Link_clocks(graph_), seed, obj)
+{
     for(size_t i = 0; i < graph_.get_edge_num(); ++i)
     {
         nodes[graph_[i].get_first_node()]->add_edge(graph_[i].get_second_node(), graph_[i].get_weight());
@@ -88,10 +199,42 @@ Emulator::Emulator(const Graph_as_vector& graph_, Id obj) : box(graph_.get_node_
     }
 }
 
+template<typename Id>
+Emulator::Emulator(const Compressed_graph& graph_, size_t seed, Id obj) : Emulator(graph_.get_node_num(), Link_clocks(graph_), seed, obj)
+{
+    for(const Compressed_graph::Edge& i : graph_)
+    {
+        nodes[i.get_first_node()]->add_edge(i.get_second_node(), i.get_weight());
+        nodes[i.get_second_node()]->add_edge(i.get_first_node(), i.get_weight());
+    }
+}
+
 template<typename Node>
 Emulator Emulator::create(const Graph_as_vector& graph)
 {
-    return Emulator(graph, Identity<Node>());
+    return Emulator(graph, rnd(0, std::numeric_limits<size_t>::max()), Identity<Node>());
 }
 
+template<typename Node>
+Emulator Emulator::create(const Graph_as_vector& graph, size_t seed)
+{
+    return Emulator(graph, seed, Identity<Node>());
+}
+
+template<typename Node>
+Emulator Emulator::create(const Compressed_graph& graph)
+{
+    return Emulator(graph, rnd(0, std::numeric_limits<size_t>::max()), Identity<Node>());
+}
+
+template<typename Node>
+Emulator Emulator::create(const Compressed_graph& graph, size_t seed)
+{
+    return Emulator(graph, seed, Identity<Node>());
+}
+
+size_t mix_signature(size_t signature, size_t value);
+
+std::ostream& operator<<(std::ostream& stream, const Emulator_progress& progress);
+
 #endif // EMULATOR_H_INCLUDED
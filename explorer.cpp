@@ -0,0 +1,114 @@
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <iostream>
+
+#include "explorer.h"
+#include "graph_as_vector.h"
+#include "emulator.h"
+#include "kruskal.h"
+#include "ghs.h"
+
+namespace
+{
+
+enum Outcome {OK, FAILED, THROWN};
+
+void print_distribution(std::ostream& stream, const char* name, std::vector<size_t> values)
+{
+    stream << name << ":";
+    if(values.empty())
+    {
+        stream << " none" << std::endl;
+        return;
+    }
+
+    std::sort(values.begin(), values.end());
+    stream << " min " << values.front()
+           << " p50 " << values[values.size() / 2]
+           << " p90 " << values[values.size() * 9 / 10]
+           << " p99 " << values[values.size() * 99 / 100]
+           << " max " << values.back() << std::endl;
+}
+
+}
+
+Exploration_report explore(const Graph_as_vector& graph, size_t schedule_num, size_t first_seed, size_t thread_num, Mst_protocol protocol)
+{
+    if(thread_num == 0)
+        thread_num = std::max(1u, std::thread::hardware_concurrency());
+
+    const Graph_as_vector reference = mst(graph);
+
+    std::vector<Outcome> outcomes(schedule_num, OK);
+    std::vector<Ghs_stats> stats(schedule_num);
+    std::atomic<size_t> next(0);
+
+    std::vector<std::thread> workers;
+    for(size_t t = 0; t < thread_num; ++t)
+        workers.emplace_back([&]()
+        {
+            for(size_t i = next++; i < schedule_num; i = next++)
+            {
+                try
+                {
+                    Ghs_options options(first_seed + i, protocol);
+                    options.stats = &stats[i];
+                    if(ghs(graph, options) != reference)
+                        outcomes[i] = FAILED;
+                }
+                catch(const std::exception&)
+                {
+                    outcomes[i] = THROWN;
+                }
+            }
+        });
+    for(std::thread& i : workers)
+        i.join();
+
+    Exploration_report report;
+    report.schedule_num = schedule_num;
+    for(size_t i = 0; i < schedule_num; ++i)
+    {
+        if(outcomes[i] == THROWN)
+        {
+            report.thrown_seeds.push_back(first_seed + i);
+            continue;
+        }
+
+        if(outcomes[i] == FAILED)
+            report.failed_seeds.push_back(first_seed + i);
+
+        report.round_nums.push_back(stats[i].round_num);
+        report.message_nums.push_back(stats[i].message_num);
+        report.times.push_back(stats[i].time);
+        report.phase_nums.push_back(stats[i].phase_num);
+    }
+
+    return report;
+}
+
+std::ostream& operator<<(std::ostream& stream, const Exploration_report& report)
+{
+    stream << "schedules " << report.schedule_num
+           << ", failed " << report.failed_seeds.size()
+           << ", thrown " << report.thrown_seeds.size() << std::endl;
+
+    stream << "failed seeds:";
+    for(size_t i : report.failed_seeds)
+        stream << " " << i;
+    stream << std::endl;
+
+    stream << "thrown seeds:";
+    for(size_t i : report.thrown_seeds)
+        stream << " " << i;
+    stream << std::endl;
+
+    print_distribution(stream, "rounds", report.round_nums);
+    print_distribution(stream, "messages", report.message_nums);
+    print_distribution(stream, "time", report.times);
+    print_distribution(stream, "phases", report.phase_nums);
+
+    return stream;
+}
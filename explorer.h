@@ -0,0 +1,21 @@
+#ifndef EXPLORER_H_INCLUDED
+#define EXPLORER_H_INCLUDED
+
+#include <vector>
+#include <iostream>
+
+#include "graph_as_vector.h"
+#include "ghs.h"
+
+struct Exploration_report
+{
+    size_t schedule_num;
+    std::vector<size_t> failed_seeds, thrown_seeds;
+    std::vector<size_t> round_nums, message_nums, times, phase_nums;
+};
+
+Exploration_report explore(const Graph_as_vector& graph, size_t schedule_num, size_t first_seed = 0, size_t thread_num = 0, Mst_protocol protocol = GHS_PROTOCOL);
+
+std::ostream& operator<<(std::ostream& stream, const Exploration_report& report);
+
+#endif // EXPLORER_H_INCLUDED
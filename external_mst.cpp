@@ -0,0 +1,581 @@
+#include <string>
+#include <vector>
+#include <queue>
+#include <memory>
+#include <future>
+#include <atomic>
+#include <fstream>
+#include <cstdio>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <tuple>
+
+#include "external_mst.h"
+#include "graph_as_vector.h"
+#include "kruskal.h"
+#include "radix_sort.h"
+#include "random.h"
+
+namespace
+{
+
+const size_t BLOCK_SIZE = 1 << 16;
+const size_t MERGE_FAN_IN = 64;
+
+struct External_edge
+{
+    size_t first, second, weight, first_original, second_original;
+};
+
+struct Label
+{
+    size_t from, to;
+};
+
+std::string temp_path(const std::string& temp_dir)
+{
+    static const size_t prefix = rnd(0, std::numeric_limits<size_t>::max());
+    static std::atomic<size_t> counter(0);
+
+    return temp_dir + "/mst_" + std::to_string(prefix) + "_" + std::to_string(counter++) + ".tmp";
+}
+
+template<typename T>
+class Block_writer
+{
+private:
+    std::ofstream stream;
+    std::vector<T> buffer, flushing;
+    std::future<void> pending;
+    size_t size;
+
+    void swap_out();
+
+public:
+    Block_writer(const std::string& path);
+    ~Block_writer();
+
+    void push(const T& value);
+    void close();
+
+    size_t get_size() const;
+};
+
+template<typename T>
+class Block_reader
+{
+private:
+    std::ifstream stream;
+    std::vector<T> buffer, loaded;
+    std::future<size_t> pending;
+    size_t position;
+
+    void prefetch();
+
+public:
+    Block_reader(const std::string& path);
+    ~Block_reader();
+
+    bool next(T& value);
+};
+
+template<typename T>
+Block_writer<T>::Block_writer(const std::string& path) : stream(path, std::ios::binary | std::ios::trunc), size(0)
+{
+    if(!stream)
+        throw bad_external_file();
+
+    buffer.reserve(BLOCK_SIZE);
+}
+
+template<typename T>
+Block_writer<T>::~Block_writer()
+{
+    if(pending.valid())
+        pending.wait();
+}
+
+template<typename T>
+void Block_writer<T>::swap_out()
+{
+    if(pending.valid())
+        pending.get();
+
+    buffer.swap(flushing);
+    buffer.clear();
+
+    pending = std::async(std::launch::async, [this]()
+    {
+        stream.write(reinterpret_cast<const char*>(flushing.data()), flushing.size() * sizeof(T));
+    });
+}
+
+template<typename T>
+void Block_writer<T>::push(const T& value)
+{
+    buffer.push_back(value);
+    ++size;
+
+    if(buffer.size() == BLOCK_SIZE)
+        swap_out();
+}
+
+template<typename T>
+void Block_writer<T>::close()
+{
+    swap_out();
+    pending.get();
+    stream.close();
+
+    if(!stream)
+        throw bad_external_file();
+}
+
+template<typename T>
+size_t Block_writer<T>::get_size() const
+{
+    return size;
+}
+
+template<typename T>
+Block_reader<T>::Block_reader(const std::string& path) : stream(path, std::ios::binary), position(0)
+{
+    if(!stream)
+        throw bad_external_file();
+
+    prefetch();
+}
+
+template<typename T>
+Block_reader<T>::~Block_reader()
+{
+    if(pending.valid())
+        pending.wait();
+}
+
+template<typename T>
+void Block_reader<T>::prefetch()
+{
+    loaded.resize(BLOCK_SIZE);
+
+    pending = std::async(std::launch::async, [this]()
+    {
+        stream.read(reinterpret_cast<char*>(loaded.data()), loaded.size() * sizeof(T));
+        return static_cast<size_t>(stream.gcount()) / sizeof(T);
+    });
+}
+
+template<typename T>
+bool Block_reader<T>::next(T& value)
+{
+    if(position == buffer.size())
+    {
+        if(!pending.valid())
+            return false;
+
+        size_t n = pending.get();
+        if(n == 0)
+            return false;
+
+        buffer.swap(loaded);
+        buffer.resize(n);
+        position = 0;
+        prefetch();
+    }
+
+    value = buffer[position++];
+    return true;
+}
+
+template<typename T, typename Key>
+void sort_by(std::vector<T>& data, Key key)
+{
+    radix_sort<CHAR_BIT>(data, sizeof(size_t), [key](const T& value, size_t d)
+    {
+        return key_byte(key(value), d);
+    });
+}
+
+template<typename T, typename Read, typename Key>
+std::vector<std::string> write_runs(Read read, Key key, size_t run_size, const std::string& temp_dir)
+{
+    std::vector<std::string> runs;
+    std::future<void> pending;
+
+    while(true)
+    {
+        std::vector<T> chunk;
+        chunk.reserve(std::min(run_size, BLOCK_SIZE));
+
+        T value;
+        while(chunk.size() < run_size && read(value))
+            chunk.push_back(value);
+
+        if(chunk.empty())
+            break;
+
+        if(pending.valid())
+            pending.get();
+
+        runs.push_back(temp_path(temp_dir));
+        pending = std::async(std::launch::async, [key](std::vector<T> data, std::string path)
+        {
+            sort_by(data, key);
+
+            std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+            stream.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(T));
+            if(!stream)
+                throw bad_external_file();
+        }, std::move(chunk), runs.back());
+    }
+
+    if(pending.valid())
+        pending.get();
+
+    return runs;
+}
+
+template<typename T, typename Key, typename Visit>
+void merge_group(const std::vector<std::string>& runs, Key key, Visit visit)
+{
+    typedef std::pair<size_t, size_t> Entry;
+
+    {
+        std::vector<std::unique_ptr<Block_reader<T>>> readers;
+        std::vector<T> heads(runs.size());
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+        for(size_t i = 0; i < runs.size(); ++i)
+        {
+            readers.push_back(std::make_unique<Block_reader<T>>(runs[i]));
+            if(readers[i]->next(heads[i]))
+                queue.push(Entry(key(heads[i]), i));
+        }
+
+        while(!queue.empty())
+        {
+            size_t i = queue.top().second;
+            queue.pop();
+
+            if(!visit(heads[i]))
+                break;
+
+            if(readers[i]->next(heads[i]))
+                queue.push(Entry(key(heads[i]), i));
+        }
+    }
+
+    for(const std::string& i : runs)
+        std::remove(i.c_str());
+}
+
+template<typename T, typename Key, typename Visit>
+void merge_runs(std::vector<std::string> runs, Key key, const std::string& temp_dir, Visit visit)
+{
+    while(runs.size() > MERGE_FAN_IN)
+    {
+        std::vector<std::string> merged;
+        for(size_t i = 0; i < runs.size(); i += MERGE_FAN_IN)
+        {
+            std::vector<std::string> group(runs.begin() + i, runs.begin() + std::min(runs.size(), i + MERGE_FAN_IN));
+            merged.push_back(temp_path(temp_dir));
+
+            Block_writer<T> writer(merged.back());
+            merge_group<T>(group, key, [&writer](const T& value)
+            {
+                writer.push(value);
+                return true;
+            });
+            writer.close();
+        }
+        runs.swap(merged);
+    }
+
+    merge_group<T>(runs, key, visit);
+}
+
+template<typename T, typename Key, typename Visit>
+void external_sort(const std::string& path, Key key, size_t run_size, const std::string& temp_dir, Visit visit)
+{
+    std::vector<std::string> runs;
+    {
+        Block_reader<T> reader(path);
+        runs = write_runs<T>([&reader](T& value)
+        {
+            return reader.next(value);
+        }, key, run_size, temp_dir);
+    }
+
+    merge_runs<T>(runs, key, temp_dir, visit);
+}
+
+size_t open_text(std::ifstream& stream, const std::string& path, size_t& edge_num)
+{
+    stream.open(path);
+    if(!stream)
+        throw bad_external_file();
+
+    size_t node_num;
+    if(!(stream >> node_num >> edge_num))
+        throw bad_external_file();
+
+    return node_num;
+}
+
+void read_edge(std::ifstream& stream, size_t& first, size_t& second, size_t& weight)
+{
+    if(!(stream >> first >> second >> weight))
+        throw bad_external_file();
+}
+
+bool lighter(const External_edge& a, const External_edge& b)
+{
+    return std::make_tuple(a.weight, std::min(a.first_original, a.second_original), std::max(a.first_original, a.second_original)) <
+           std::make_tuple(b.weight, std::min(b.first_original, b.second_original), std::max(b.first_original, b.second_original));
+}
+
+bool is_leaf(size_t node, size_t phase)
+{
+    size_t key = node + phase * 0x9e3779b97f4a7c15ull;
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ull;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebull;
+    return ((key ^ (key >> 31)) & 1) != 0;
+}
+
+std::string relabel(const std::string& edges, const std::string& labels, bool second, size_t run_size, const std::string& temp_dir, size_t& edge_num)
+{
+    std::string result = temp_path(temp_dir);
+    Block_writer<External_edge> writer(result);
+    Block_reader<Label> reader(labels);
+
+    Label label;
+    bool has_label = reader.next(label);
+
+    external_sort<External_edge>(edges, [second](const External_edge& e)
+    {
+        return second ? e.second : e.first;
+    }, run_size, temp_dir, [&](External_edge e)
+    {
+        size_t& end = second ? e.second : e.first;
+        while(has_label && label.from < end)
+            has_label = reader.next(label);
+        if(has_label && label.from == end)
+            end = label.to;
+
+        if(!second || e.first != e.second)
+            writer.push(e);
+        return true;
+    });
+
+    writer.close();
+    edge_num = writer.get_size();
+    std::remove(edges.c_str());
+
+    return result;
+}
+
+std::string compact(const std::string& edges, size_t run_size, const std::string& temp_dir, size_t& node_num)
+{
+    std::string ends = temp_path(temp_dir);
+    {
+        Block_writer<size_t> writer(ends);
+        Block_reader<External_edge> reader(edges);
+        External_edge e;
+        while(reader.next(e))
+        {
+            writer.push(e.first);
+            writer.push(e.second);
+        }
+        writer.close();
+    }
+
+    std::string labels = temp_path(temp_dir);
+    {
+        Block_writer<Label> writer(labels);
+        size_t last = 0;
+        external_sort<size_t>(ends, [](size_t v)
+        {
+            return v;
+        }, run_size, temp_dir, [&](size_t v)
+        {
+            if(writer.get_size() == 0 || v != last)
+                writer.push(Label{v, writer.get_size()});
+            last = v;
+            return true;
+        });
+        writer.close();
+        node_num = writer.get_size();
+    }
+    std::remove(ends.c_str());
+
+    return labels;
+}
+
+}
+
+Graph_as_vector semi_external_mst(const std::string& path, const std::string& temp_dir, size_t run_size)
+{
+    typedef Graph_as_vector::Edge Edge;
+
+    std::ifstream stream;
+    size_t edge_num, read_num = 0;
+    size_t node_num = open_text(stream, path, edge_num);
+
+    std::vector<std::string> runs = write_runs<Edge>([&](Edge& e)
+    {
+        if(read_num == edge_num)
+            return false;
+
+        size_t first, second, weight;
+        read_edge(stream, first, second, weight);
+        e = Edge(first, second, weight);
+        ++read_num;
+        return true;
+    }, [](const Edge& e)
+    {
+        return e.get_weight();
+    }, run_size, temp_dir);
+
+    Graph_as_vector result;
+    Dsu dsu;
+
+    for(size_t i = 0; i < node_num; ++i)
+        dsu.make_set(i);
+
+    merge_runs<Edge>(runs, [](const Edge& e)
+    {
+        return e.get_weight();
+    }, temp_dir, [&](const Edge& e)
+    {
+        if(dsu.find_set(e.get_first_node()) != dsu.find_set(e.get_second_node()))
+        {
+            result.add_edge(e);
+            dsu.union_sets(e.get_first_node(), e.get_second_node());
+        }
+        return result.get_edge_num() + 1 < node_num;
+    });
+
+    result.standartize();
+    return result;
+}
+
+size_t external_mst(const std::string& path, const std::string& output_path, const std::string& temp_dir, size_t node_budget, size_t run_size)
+{
+    std::ofstream output(output_path);
+    if(!output)
+        throw bad_external_file();
+
+    std::ifstream stream;
+    size_t edge_num;
+    size_t node_num = open_text(stream, path, edge_num);
+
+    std::string edges = temp_path(temp_dir);
+    {
+        Block_writer<External_edge> writer(edges);
+        for(size_t i = 0; i < edge_num; ++i)
+        {
+            size_t first, second, weight;
+            read_edge(stream, first, second, weight);
+            if(first != second)
+                writer.push(External_edge{first, second, weight, first, second});
+        }
+        writer.close();
+        edge_num = writer.get_size();
+    }
+
+    size_t result_num = 0;
+    for(size_t phase = 0; node_num > node_budget && edge_num > 0; ++phase)
+    {
+        std::string directed = temp_path(temp_dir);
+        {
+            Block_writer<External_edge> writer(directed);
+            Block_reader<External_edge> reader(edges);
+            External_edge e;
+            while(reader.next(e))
+            {
+                writer.push(e);
+                writer.push(External_edge{e.second, e.first, e.weight, e.second_original, e.first_original});
+            }
+            writer.close();
+        }
+
+        std::string labels = temp_path(temp_dir);
+        {
+            Block_writer<Label> writer(labels);
+            External_edge best;
+            bool open = false;
+
+            auto contract = [&]()
+            {
+                if(open && is_leaf(best.first, phase) && !is_leaf(best.second, phase))
+                {
+                    writer.push(Label{best.first, best.second});
+                    output << best.first_original << " " << best.second_original << " " << best.weight << std::endl;
+                }
+            };
+
+            external_sort<External_edge>(directed, [](const External_edge& e)
+            {
+                return e.first;
+            }, run_size, temp_dir, [&](const External_edge& e)
+            {
+                if(!open || e.first != best.first)
+                {
+                    contract();
+                    best = e;
+                    open = true;
+                }
+                else if(lighter(e, best))
+                    best = e;
+                return true;
+            });
+            contract();
+
+            writer.close();
+            node_num -= writer.get_size();
+            result_num += writer.get_size();
+        }
+        std::remove(directed.c_str());
+
+        edges = relabel(edges, labels, false, run_size, temp_dir, edge_num);
+        edges = relabel(edges, labels, true, run_size, temp_dir, edge_num);
+        std::remove(labels.c_str());
+    }
+
+    if(edge_num > 0)
+    {
+        std::string labels = compact(edges, run_size, temp_dir, node_num);
+        edges = relabel(edges, labels, false, run_size, temp_dir, edge_num);
+        edges = relabel(edges, labels, true, run_size, temp_dir, edge_num);
+        std::remove(labels.c_str());
+
+        Dsu dsu;
+        for(size_t i = 0; i < node_num; ++i)
+            dsu.make_set(i);
+
+        size_t tree_num = 0;
+        external_sort<External_edge>(edges, [](const External_edge& e)
+        {
+            return e.weight;
+        }, run_size, temp_dir, [&](const External_edge& e)
+        {
+            if(dsu.find_set(e.first) != dsu.find_set(e.second))
+            {
+                output << e.first_original << " " << e.second_original << " " << e.weight << std::endl;
+                dsu.union_sets(e.first, e.second);
+                ++tree_num;
+            }
+            return tree_num + 1 < node_num;
+        });
+        result_num += tree_num;
+    }
+    std::remove(edges.c_str());
+
+    output.close();
+    if(!output)
+        throw bad_external_file();
+
+    return result_num;
+}
@@ -0,0 +1,18 @@
+#ifndef EXTERNAL_MST_H_INCLUDED
+#define EXTERNAL_MST_H_INCLUDED
+
+#include <string>
+#include <stdexcept>
+
+#include "graph_as_vector.h"
+
+class bad_external_file : public std::exception
+{
+};
+
+constexpr size_t EXTERNAL_RUN_SIZE = size_t(1) << 22;
+
+Graph_as_vector semi_external_mst(const std::string& path, const std::string& temp_dir, size_t run_size = EXTERNAL_RUN_SIZE);
+size_t external_mst(const std::string& path, const std::string& output_path, const std::string& temp_dir, size_t node_budget, size_t run_size = EXTERNAL_RUN_SIZE);
+
+#endif // EXTERNAL_MST_H_INCLUDED
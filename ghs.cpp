@@ -1,14 +1,57 @@
 #include <memory>
+#include <vector>
+#include <queue>
+#include <utility>
+#include <unordered_map>
+#include <unordered_set>
+#include <limits>
+#include <algorithm>
+#include <functional>
 
+#include "ghs.h"
 #include "graph_as_vector.h"
+#include "compressed_graph.h"
 #include "emulator.h"
 #include "node.h"
+#include "gkp_node.h"
+#include "boruvka_node.h"
+#include "kruskal.h"
+#include "trace.h"
+#include "profile.h"
+#include "scheduler.h"
 
-Graph_as_vector ghs(const Graph_as_vector& graph)
+namespace
+{
+
+template<typename Graph>
+Emulator create(const Graph& graph, size_t seed, Mst_protocol protocol)
 {
-    Emulator e = Emulator::create<Node>(graph);
-    e.process();
+    switch(protocol)
+    {
+    case GKP_PROTOCOL:
+        return Emulator::create<Gkp_node>(graph, seed);
+    case BORUVKA_PROTOCOL:
+        return Emulator::create<Boruvka_node>(graph, seed);
+    default:
+        return Emulator::create<Node>(graph, seed);
+    }
+}
+
+template<typename Graph>
+void collect_stats(Emulator& e, const Graph& graph, Ghs_stats& stats)
+{
+    stats.round_num = e.get_round_num();
+    stats.message_num = e.get_message_num();
+    stats.time = e.get_time();
+
+    stats.phase_num = 0;
+    for(size_t i = 0; i < graph.get_node_num(); ++i)
+        stats.phase_num = std::max(stats.phase_num, std::dynamic_pointer_cast<const Ghs_node>(e[i])->get_phase_num());
+}
 
+template<typename Graph>
+Graph_as_vector collect_branches(Emulator& e, const Graph& graph)
+{
     Graph_as_vector result(graph.get_node_num());
     for(size_t i = 0; i < graph.get_node_num(); ++i)
         result.add_edges(std::dynamic_pointer_cast<const Ghs_node>(e[i])->get_branches());
@@ -17,3 +60,218 @@ Graph_as_vector ghs(const Graph_as_vector& graph)
 
     return result;
 }
+
+Graph_as_vector valid_forest(const Graph_as_vector& graph, const Graph_as_vector& previous_mst, const Graph_as_vector& changed_edges)
+{
+    std::unordered_map<Graph_as_vector::Primitive_edge, size_t> weights;
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+        weights[Graph_as_vector::Primitive_edge(graph[i]).standartize()] = graph[i].get_weight();
+
+    std::vector<std::vector<std::pair<size_t, size_t>>> tree(graph.get_node_num());
+    for(size_t i = 0; i < previous_mst.get_edge_num(); ++i)
+    {
+        tree[previous_mst[i].get_first_node()].push_back(std::make_pair(previous_mst[i].get_second_node(), previous_mst[i].get_weight()));
+        tree[previous_mst[i].get_second_node()].push_back(std::make_pair(previous_mst[i].get_first_node(), previous_mst[i].get_weight()));
+    }
+
+    const size_t UDEF = std::numeric_limits<size_t>::max();
+    std::vector<size_t> parent(graph.get_node_num(), UDEF), depth(graph.get_node_num(), 0), root(graph.get_node_num(), UDEF);
+    for(size_t r = 0; r < graph.get_node_num(); ++r)
+    {
+        if(root[r] != UDEF)
+            continue;
+
+        std::queue<size_t> order;
+        order.push(r);
+        root[r] = r;
+        while(!order.empty())
+        {
+            size_t v = order.front();
+            order.pop();
+            for(const std::pair<size_t, size_t>& i : tree[v])
+                if(root[i.first] == UDEF)
+                {
+                    root[i.first] = r;
+                    parent[i.first] = v;
+                    depth[i.first] = depth[v] + 1;
+                    order.push(i.first);
+                }
+        }
+    }
+
+    std::unordered_set<Graph_as_vector::Primitive_edge> dropped;
+    for(size_t i = 0; i < previous_mst.get_edge_num(); ++i)
+    {
+        Graph_as_vector::Primitive_edge e = Graph_as_vector::Primitive_edge(previous_mst[i]).standartize();
+        std::unordered_map<Graph_as_vector::Primitive_edge, size_t>::const_iterator j = weights.find(e);
+        if(j == weights.end() || j->second > previous_mst[i].get_weight())
+            dropped.insert(e);
+    }
+
+    for(size_t i = 0; i < changed_edges.get_edge_num(); ++i)
+    {
+        std::unordered_map<Graph_as_vector::Primitive_edge, size_t>::const_iterator j = weights.find(Graph_as_vector::Primitive_edge(changed_edges[i]).standartize());
+        size_t u = changed_edges[i].get_first_node(), v = changed_edges[i].get_second_node();
+        if(j == weights.end() || root[u] != root[v])
+            continue;
+
+        while(u != v)
+        {
+            if(depth[u] < depth[v])
+                std::swap(u, v);
+
+            Graph_as_vector::Primitive_edge e = Graph_as_vector::Primitive_edge(u, parent[u]).standartize();
+            std::unordered_map<Graph_as_vector::Primitive_edge, size_t>::const_iterator k = weights.find(e);
+            if(k != weights.end() && k->second > j->second)
+                dropped.insert(e);
+
+            u = parent[u];
+        }
+    }
+
+    Graph_as_vector result(graph.get_node_num());
+    for(size_t i = 0; i < previous_mst.get_edge_num(); ++i)
+    {
+        Graph_as_vector::Primitive_edge e = Graph_as_vector::Primitive_edge(previous_mst[i]).standartize();
+        if(!dropped.count(e))
+            result.add_edge(Graph_as_vector::Edge(e.get_first_node(), e.get_second_node(), weights[e]));
+    }
+
+    return result;
+}
+
+template<typename Graph>
+Graph_as_vector run(Emulator& e, const Graph& graph, const Ghs_options& options)
+{
+    if(options.scheduler)
+        e.set_scheduler(options.scheduler);
+    e.set_trace(options.trace);
+    e.set_progress(options.progress, options.progress_interval);
+    e.set_livelock_rounds(options.livelock_rounds);
+
+    if(options.profile)
+        take_handler_profile();
+
+    if(options.replay)
+        e.replay(*options.replay);
+    else
+        e.process();
+
+    if(options.profile)
+        *options.profile = take_handler_profile();
+    if(options.trace)
+        options.trace->flush();
+    if(options.stats)
+        collect_stats(e, graph, *options.stats);
+
+    return collect_branches(e, graph);
+}
+
+void warm_start(Emulator& e, const Graph_as_vector& graph, const Graph_as_vector& forest)
+{
+    Dsu dsu;
+    for(size_t i = 0; i < graph.get_node_num(); ++i)
+        dsu.make_set(i);
+    for(size_t i = 0; i < forest.get_edge_num(); ++i)
+        dsu.union_sets(forest[i].get_first_node(), forest[i].get_second_node());
+
+    std::unordered_map<size_t, size_t> sizes, cores;
+    for(size_t i = 0; i < graph.get_node_num(); ++i)
+        ++sizes[dsu.find_set(i)];
+    for(size_t i = 0; i < forest.get_edge_num(); ++i)
+        cores.insert(std::make_pair(dsu.find_set(forest[i].get_first_node()), i));
+
+    std::unordered_map<size_t, Component> components;
+    for(const std::pair<const size_t, size_t>& i : cores)
+    {
+        size_t level = 0;
+        while((size_t(2) << level) <= sizes[i.first])
+            ++level;
+        components.insert(std::make_pair(i.first, Component(forest[i.second].get_weight(), level)));
+    }
+
+
+    std::unordered_set<Graph_as_vector::Primitive_edge> branches;
+    for(size_t i = 0; i < forest.get_edge_num(); ++i)
+    {
+        branches.insert(forest[i]);
+        std::dynamic_pointer_cast<Node>(e[forest[i].get_first_node()])->set_edge_state(forest[i].get_second_node(), Edge::BRANCH);
+        std::dynamic_pointer_cast<Node>(e[forest[i].get_second_node()])->set_edge_state(forest[i].get_first_node(), Edge::BRANCH);
+    }
+
+    std::unordered_set<size_t> open;
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+    {
+        size_t u = graph[i].get_first_node(), v = graph[i].get_second_node();
+        if(dsu.find_set(u) != dsu.find_set(v))
+        {
+            open.insert(dsu.find_set(u));
+            open.insert(dsu.find_set(v));
+        }
+        else if(components.count(dsu.find_set(u)) && !branches.count(Graph_as_vector::Primitive_edge(u, v).standartize()))
+        {
+            std::dynamic_pointer_cast<Node>(e[u])->set_edge_state(v, Edge::REJECTED);
+            std::dynamic_pointer_cast<Node>(e[v])->set_edge_state(u, Edge::REJECTED);
+        }
+    }
+
+    for(size_t i = 0; i < graph.get_node_num(); ++i)
+    {
+        std::unordered_map<size_t, Component>::const_iterator j = components.find(dsu.find_set(i));
+        if(j != components.end())
+            std::dynamic_pointer_cast<Node>(e[i])->seed(j->second, open.count(j->first) ? Node::FOUND : Node::END);
+    }
+
+    for(const std::pair<const size_t, size_t>& i : cores)
+    {
+        if(!open.count(i.first))
+            continue;
+
+        const Graph_as_vector::Edge& core = forest[i.second];
+        const Component& component = components.find(i.first)->second;
+        e.post(std::make_shared<INIT>(core.get_first_node(), core.get_second_node(), component, Node::SEARCH));
+        e.post(std::make_shared<INIT>(core.get_second_node(), core.get_first_node(), component, Node::SEARCH));
+    }
+}
+
+}
+
+size_t Ghs_node::get_phase_num() const
+{
+    return 0;
+}
+
+Graph_as_vector ghs(const Graph_as_vector& graph)
+{
+    return ghs(graph, Ghs_options());
+}
+
+Graph_as_vector ghs(const Graph_as_vector& graph, const Ghs_options& options)
+{
+    Emulator e = create(graph, options.seed, options.protocol);
+
+    if(options.previous_mst)
+    {
+        if(options.protocol != GHS_PROTOCOL)
+            throw bad_ghs();
+
+        warm_start(e, graph, valid_forest(graph, *options.previous_mst, options.changed_edges ? *options.changed_edges : Graph_as_vector(graph.get_node_num())));
+    }
+
+    return run(e, graph, options);
+}
+
+Graph_as_vector ghs(const Compressed_graph& graph)
+{
+    return ghs(graph, Ghs_options());
+}
+
+Graph_as_vector ghs(const Compressed_graph& graph, const Ghs_options& options)
+{
+    if(options.previous_mst)
+        throw bad_ghs();
+
+    Emulator e = create(graph, options.seed, options.protocol);
+
+    return run(e, graph, options);
+}
@@ -1,15 +1,54 @@
 #ifndef GHS_H_INCLUDED
 #define GHS_H_INCLUDED
 
+#include <memory>
+#include <functional>
+#include <limits>
+
 #include "graph_as_vector.h"
+#include "compressed_graph.h"
+#include "emulator.h"
+#include "random.h"
+#include "trace.h"
+#include "profile.h"
+#include "scheduler.h"
 
 class Ghs_node
 {
 public:
     virtual Graph_as_vector get_branches() const = 0;
+    virtual size_t get_phase_num() const;
     virtual ~Ghs_node() = default;
 };
 
+enum Mst_protocol {GHS_PROTOCOL, GKP_PROTOCOL, BORUVKA_PROTOCOL};
+
+struct Ghs_stats
+{
+    size_t round_num, message_num, time, phase_num;
+};
+
+struct Ghs_options
+{
+    size_t seed;
+    Mst_protocol protocol;
+    Ghs_stats* stats;
+    std::shared_ptr<Scheduler> scheduler;
+    Trace_writer* trace;
+    Trace_reader* replay;
+    Handler_profile* profile;
+    std::function<void(const Emulator_progress&)> progress;
+    size_t progress_interval, livelock_rounds;
+    const Graph_as_vector* previous_mst;
+    const Graph_as_vector* changed_edges;
+
+    explicit Ghs_options(size_t seed = rnd(0, std::numeric_limits<size_t>::max()), Mst_protocol protocol = GHS_PROTOCOL) : seed(seed), protocol(protocol), stats(nullptr), trace(nullptr), replay(nullptr), profile(nullptr),
+        progress_interval(0), livelock_rounds(0), previous_mst(nullptr), changed_edges(nullptr) {};
+};
+
 Graph_as_vector ghs(const Graph_as_vector& graph);
+Graph_as_vector ghs(const Graph_as_vector& graph, const Ghs_options& options);
+Graph_as_vector ghs(const Compressed_graph& graph);
+Graph_as_vector ghs(const Compressed_graph& graph, const Ghs_options& options);
 
 #endif // GHS_H_INCLUDED
@@ -0,0 +1,409 @@
+#include <vector>
+#include <deque>
+#include <set>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include <memory>
+
+#include "gkp_node.h"
+#include "emulator.h"
+#include "boruvka_node.h"
+
+unsigned char Gkp_query::get_type() const
+{
+    return type;
+}
+
+const char* Gkp_query::get_name() const
+{
+    static const char* const NAMES[] = {"WAVE", "ECHO", "FRAGMENT", "EDGE", "DONE", "DOWN", "END"};
+    return NAMES[type];
+}
+
+size_t Gkp_query::get_payload(size_t i) const
+{
+    return i == 0 ? wave : weight;
+}
+
+Gkp_node::Gkp_node() : wave(UDEF), parent(UDEF), pending(0), state(Gkp_node::SLEEP), done(false), fragment_final(false), fragment(UDEF), fragments_known(0)
+{
+}
+
+void Gkp_node::set_id(size_t id_)
+{
+    id = id_;
+    fragment_node.set_id(id_);
+}
+
+void Gkp_node::set_node_num(size_t node_num)
+{
+    size_t phase_cap = 0, depth_cap = 0;
+    while((size_t(1) << phase_cap) < node_num)
+        ++phase_cap;
+    while(depth_cap * depth_cap < node_num)
+        ++depth_cap;
+
+    fragment_node.set_phase_cap(phase_cap);
+    fragment_node.set_depth_cap(depth_cap);
+}
+
+void Gkp_node::add_edge(size_t end, size_t weight)
+{
+    edges.push_back(std::make_pair(end, weight));
+    neighbour_fragments.push_back(UDEF);
+    branches.push_back(false);
+    fragment_node.add_edge(end, weight);
+}
+
+Graph_as_vector Gkp_node::get_branches() const
+{
+    Graph_as_vector result = fragment_node.get_branches();
+
+    for(size_t i = 0; i < edges.size(); ++i)
+        if(branches[i])
+            result.add_edge(Graph_as_vector::Edge(id, edges[i].first, edges[i].second));
+
+    return result;
+}
+
+bool Gkp_node::ended() const
+{
+    return state == Gkp_node::END;
+}
+
+unsigned char Gkp_node::get_state() const
+{
+    return state;
+}
+
+size_t Gkp_node::get_fragment() const
+{
+    return fragment_final ? fragment : fragment_node.get_fragment();
+}
+
+size_t Gkp_node::get_signature() const
+{
+    size_t signature = mix_signature(Emulator_node::get_signature(), fragment_node.get_signature());
+    for(size_t i : {wave, parent, pending, fragments_known, size_t(done), children.size(), candidates.size(), origins.size(), components.size()})
+        signature = mix_signature(signature, i);
+
+    signature = mix_signature(signature, std::count(heard.begin(), heard.end(), true));
+    signature = mix_signature(signature, std::count(finished.begin(), finished.end(), true));
+    if(!candidates.empty())
+        signature = mix_signature(signature, std::get<0>(candidates.begin()->first));
+
+    return signature;
+}
+
+size_t Gkp_node::get_phase_num() const
+{
+    return fragment_node.get_phase_num() + 1;
+}
+
+const std::deque<std::shared_ptr<const Emulator_query>>& Gkp_node::wake_up()
+{
+    result = std::deque<std::shared_ptr<const Emulator_query>>();
+
+    if(state == Gkp_node::SLEEP)
+    {
+        state = Gkp_node::ELECTION;
+        forward(fragment_node.wake_up());
+        check_fragment();
+
+        if(edges.empty())
+            end();
+    }
+
+    return result;
+}
+
+const std::deque<std::shared_ptr<const Emulator_query>>& Gkp_node::tick(std::shared_ptr<const Emulator_query> q_)
+{
+    result = std::deque<std::shared_ptr<const Emulator_query>>();
+
+    if(state == Gkp_node::SLEEP)
+        state = Gkp_node::ELECTION;
+
+    if(std::dynamic_pointer_cast<const Boruvka_query>(q_))
+    {
+        forward(fragment_node.tick(q_));
+        check_fragment();
+        return result;
+    }
+
+    if(fragment_node.get_state() == Boruvka_node::SLEEP)
+    {
+        forward(fragment_node.wake_up());
+        check_fragment();
+    }
+
+    const Gkp_query& q = *std::static_pointer_cast<const Gkp_query>(q_);
+    Key key(q.weight, q.first, q.second, q.first_fragment, q.second_fragment);
+
+    if(q.type != Gkp_query::WAVE && q.type != Gkp_query::FRAGMENT && q.wave != wave)
+        return result;
+
+    switch(q.type)
+    {
+    case Gkp_query::WAVE:
+        on_wave(q.get_sender(), q.wave);
+        break;
+    case Gkp_query::ECHO:
+        on_echo(q.get_sender());
+        break;
+    case Gkp_query::FRAGMENT:
+        on_fragment(q.get_sender(), q.weight);
+        break;
+    case Gkp_query::EDGE:
+        on_edge(q.get_sender(), key);
+        break;
+    case Gkp_query::DONE:
+        on_done(q.get_sender());
+        break;
+    case Gkp_query::DOWN:
+        downcast(key);
+        break;
+    case Gkp_query::END:
+        end();
+        break;
+    }
+
+    return result;
+}
+
+size_t Gkp_node::get_edge(size_t end) const
+{
+    return std::distance(edges.begin(), std::find_if(edges.begin(), edges.end(), [end](const std::pair<size_t, size_t>& e)
+    {
+        return e.first == end;
+    }));
+}
+
+size_t Gkp_node::find(size_t v)
+{
+    std::unordered_map<size_t, size_t>::iterator i = components.find(v);
+    if(i == components.end())
+        return v;
+
+    while(true)
+    {
+        std::unordered_map<size_t, size_t>::iterator j = components.find(i->second);
+        if(j == components.end())
+            return i->second;
+
+        i->second = j->second;
+        i = j;
+    }
+}
+
+void Gkp_node::send(size_t recipient, Gkp_query::Type type, const Key& key)
+{
+    result.push_back(std::make_shared<Gkp_query>(id, recipient, type, wave, std::get<0>(key), std::get<1>(key), std::get<2>(key), std::get<3>(key), std::get<4>(key)));
+}
+
+void Gkp_node::forward(const std::deque<std::shared_ptr<const Emulator_query>>& queries)
+{
+    result.insert(result.end(), queries.begin(), queries.end());
+}
+
+void Gkp_node::check_fragment()
+{
+    if(fragment_final || !fragment_node.ended())
+        return;
+
+    fragment_final = true;
+    fragment = fragment_node.get_fragment();
+    for(const std::pair<size_t, size_t>& i : edges)
+        send(i.first, Gkp_query::FRAGMENT, Key(fragment, 0, 0, 0, 0));
+
+    if(fragment == id && !edges.empty() && (wave == UDEF || id > wave))
+    {
+        reset_wave(id, id);
+        pending = edges.size();
+        send_wave(UDEF);
+    }
+
+    try_start();
+}
+
+void Gkp_node::on_fragment(size_t sender, size_t f)
+{
+    neighbour_fragments[get_edge(sender)] = f;
+    ++fragments_known;
+
+    try_start();
+}
+
+void Gkp_node::send_wave(size_t except)
+{
+    for(const std::pair<size_t, size_t>& i : edges)
+        if(i.first != except)
+            send(i.first, Gkp_query::WAVE);
+}
+
+void Gkp_node::finish_wave()
+{
+    if(parent != id)
+        send(parent, Gkp_query::ECHO);
+
+    try_start();
+}
+
+void Gkp_node::reset_wave(size_t w, size_t sender)
+{
+    wave = w;
+    parent = sender;
+    state = Gkp_node::ELECTION;
+    done = false;
+    children.clear();
+    child_index.clear();
+    last.clear();
+    heard.clear();
+    finished.clear();
+    candidates.clear();
+    origins.clear();
+    components.clear();
+}
+
+void Gkp_node::on_wave(size_t sender, size_t w)
+{
+    if(wave == UDEF || w > wave)
+    {
+        reset_wave(w, sender);
+        pending = edges.size() - 1;
+
+        send_wave(sender);
+        if(pending == 0)
+            finish_wave();
+    }
+    else if(w == wave && --pending == 0)
+        finish_wave();
+}
+
+void Gkp_node::on_echo(size_t sender)
+{
+    child_index[sender] = children.size();
+    children.push_back(sender);
+    last.push_back(Key(0, 0, 0, 0, 0));
+    heard.push_back(false);
+    finished.push_back(false);
+
+    if(--pending == 0)
+        finish_wave();
+}
+
+void Gkp_node::try_start()
+{
+    if(state != Gkp_node::ELECTION || wave == UDEF || pending != 0 || !fragment_final || fragments_known != edges.size())
+        return;
+
+    state = Gkp_node::PIPELINE;
+
+    for(size_t i = 0; i < edges.size(); ++i)
+        if(neighbour_fragments[i] != fragment)
+        {
+            size_t end = edges[i].first;
+            if(id < end)
+                candidates.insert(std::make_pair(Key(edges[i].second, id, end, fragment, neighbour_fragments[i]), id));
+            else
+                candidates.insert(std::make_pair(Key(edges[i].second, end, id, neighbour_fragments[i], fragment), id));
+        }
+
+    advance();
+}
+
+void Gkp_node::on_edge(size_t sender, const Key& key)
+{
+    size_t i = child_index[sender];
+    heard[i] = true;
+    last[i] = key;
+    candidates.insert(std::make_pair(key, sender));
+
+    if(state == Gkp_node::PIPELINE)
+        advance();
+}
+
+void Gkp_node::on_done(size_t sender)
+{
+    finished[child_index[sender]] = true;
+
+    if(state == Gkp_node::PIPELINE)
+        advance();
+}
+
+void Gkp_node::advance()
+{
+    while(!candidates.empty())
+    {
+        Key key = candidates.begin()->first;
+        for(size_t i = 0; i < children.size(); ++i)
+            if(!finished[i] && (!heard[i] || last[i] < key))
+                return;
+
+        std::vector<size_t> from;
+        while(!candidates.empty() && candidates.begin()->first == key)
+        {
+            from.push_back(candidates.begin()->second);
+            candidates.erase(candidates.begin());
+        }
+
+        emit(key, from);
+    }
+
+    if(done || std::find(finished.begin(), finished.end(), false) != finished.end())
+        return;
+
+    done = true;
+    if(parent == id)
+        end();
+    else
+        send(parent, Gkp_query::DONE);
+}
+
+void Gkp_node::emit(const Key& key, const std::vector<size_t>& from)
+{
+    size_t a = find(std::get<3>(key)), b = find(std::get<4>(key));
+    if(a != b)
+    {
+        components[a] = b;
+        origins[key] = from;
+
+        if(parent == id)
+            downcast(key);
+        else
+            send(parent, Gkp_query::EDGE, key);
+        return;
+    }
+
+    std::map<Key, std::vector<size_t>>::iterator i = origins.find(key);
+    if(i != origins.end())
+        i->second.insert(i->second.end(), from.begin(), from.end());
+}
+
+void Gkp_node::downcast(const Key& key)
+{
+    std::map<Key, std::vector<size_t>>::iterator i = origins.find(key);
+    if(i == origins.end())
+        return;
+
+    for(size_t j : i->second)
+        if(j != id)
+            send(j, Gkp_query::DOWN, key);
+        else
+            branches[get_edge(std::get<1>(key) == id ? std::get<2>(key) : std::get<1>(key))] = true;
+
+    origins.erase(i);
+}
+
+void Gkp_node::end()
+{
+    state = Gkp_node::END;
+    for(size_t i : children)
+        send(i, Gkp_query::END);
+
+    candidates.clear();
+    origins.clear();
+    components.clear();
+}
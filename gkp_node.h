@@ -0,0 +1,103 @@
+#ifndef GKP_NODE_H_INCLUDED
+#define GKP_NODE_H_INCLUDED
+
+#include <vector>
+#include <deque>
+#include <set>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <limits>
+#include <memory>
+
+#include "graph_as_vector.h"
+#include "emulator.h"
+#include "boruvka_node.h"
+#include "ghs.h"
+
+struct Gkp_query : public Emulator_query
+{
+    enum Type : unsigned char {WAVE, ECHO, FRAGMENT, EDGE, DONE, DOWN, END};
+
+    Type type;
+    size_t wave, weight, first, second, first_fragment, second_fragment;
+
+    Gkp_query(size_t sender, size_t recipient, Type type, size_t wave, size_t weight = 0, size_t first = 0, size_t second = 0, size_t first_fragment = 0, size_t second_fragment = 0) :
+        Emulator_query(sender, recipient), type(type), wave(wave), weight(weight), first(first), second(second), first_fragment(first_fragment), second_fragment(second_fragment) {};
+
+    virtual unsigned char get_type() const override;
+    virtual const char* get_name() const override;
+    virtual size_t get_payload(size_t i) const override;
+};
+
+class Gkp_node : public Emulator_node, public Ghs_node
+{
+public:
+    enum State {SLEEP, ELECTION, PIPELINE, END};
+
+private:
+    typedef std::tuple<size_t, size_t, size_t, size_t, size_t> Key;
+
+    static constexpr size_t UDEF = std::numeric_limits<size_t>::max();
+
+    size_t id, wave, parent, pending;
+    State state;
+    bool done;
+
+    Boruvka_node fragment_node;
+    bool fragment_final;
+    size_t fragment, fragments_known;
+
+    std::vector<std::pair<size_t, size_t>> edges;
+    std::vector<size_t> neighbour_fragments;
+    std::vector<bool> branches;
+
+    std::vector<size_t> children;
+    std::unordered_map<size_t, size_t> child_index;
+    std::vector<Key> last;
+    std::vector<bool> heard, finished;
+
+    std::set<std::pair<Key, size_t>> candidates;
+    std::map<Key, std::vector<size_t>> origins;
+    std::unordered_map<size_t, size_t> components;
+
+    std::deque<std::shared_ptr<const Emulator_query>> result;
+
+    size_t get_edge(size_t end) const;
+    size_t find(size_t v);
+    void send(size_t recipient, Gkp_query::Type type, const Key& key = Key(0, 0, 0, 0, 0));
+    void forward(const std::deque<std::shared_ptr<const Emulator_query>>& queries);
+    void check_fragment();
+    void reset_wave(size_t w, size_t sender);
+    void send_wave(size_t except);
+    void finish_wave();
+    void try_start();
+    void advance();
+    void emit(const Key& key, const std::vector<size_t>& from);
+    void downcast(const Key& key);
+    void end();
+
+    void on_wave(size_t sender, size_t w);
+    void on_echo(size_t sender);
+    void on_fragment(size_t sender, size_t f);
+    void on_edge(size_t sender, const Key& key);
+    void on_done(size_t sender);
+
+public:
+    Gkp_node();
+
+    virtual void set_id(size_t id_) override;
+    virtual void set_node_num(size_t node_num) override;
+    virtual const std::deque<std::shared_ptr<const Emulator_query>>& tick(std::shared_ptr<const Emulator_query> q) override;
+    virtual Graph_as_vector get_branches() const override;
+    virtual void add_edge(size_t end, size_t weight) override;
+    virtual const std::deque<std::shared_ptr<const Emulator_query>>& wake_up() override;
+    virtual bool ended() const override;
+    virtual unsigned char get_state() const override;
+    virtual size_t get_fragment() const override;
+    virtual size_t get_signature() const override;
+    virtual size_t get_phase_num() const override;
+};
+
+#endif // GKP_NODE_H_INCLUDED
@@ -4,85 +4,332 @@
 #include <vector>
 #include <iostream>
 #include <unordered_set>
-#include <climits>
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
+#include <type_traits>
+#include <climits>
+
+#include "radix_sort.h"
 
 class graph_as_vector_misuse : public std::exception
 {
 };
 
-class Graph_as_vector
+template<typename Weight>
+constexpr Weight infinite_weight()
 {
+    return std::numeric_limits<Weight>::has_infinity ? std::numeric_limits<Weight>::infinity() : std::numeric_limits<Weight>::max();
+}
+
+template<typename Index>
+class Basic_primitive_edge
+{
+private:
+    Index first_node, second_node;
+
 public:
-    class Primitive_edge
-    {
-    private:
-        size_t first_node, second_node;
+    Basic_primitive_edge() = default;
+    Basic_primitive_edge(Index first_node, Index second_node) : first_node(first_node), second_node(second_node) {};
 
-    public:
-        Primitive_edge() = default;
-        Primitive_edge(size_t first_node, size_t second_node) : first_node(first_node), second_node(second_node) {};
+    const Basic_primitive_edge& standartize();
 
-        const Primitive_edge& standartize();
+    Index get_first_node() const;
+    Index get_second_node() const;
 
-        size_t get_first_node() const;
-        size_t get_second_node() const;
+    bool operator==(const Basic_primitive_edge& e) const;
+    bool operator!=(const Basic_primitive_edge& e) const;
+};
 
-        bool operator==(const Primitive_edge& e) const;
-        bool operator!=(const Primitive_edge& e) const;
-    };
+template<typename Index, typename Weight>
+class Basic_edge : public Basic_primitive_edge<Index>
+{
+private:
+    Weight weight;
 
-    class Edge : public Primitive_edge
-    {
-    private:
-        size_t weight;
+public:
+    Basic_edge() = default;
+    Basic_edge(Index first_node, Index second_node, Weight weight) : Basic_primitive_edge<Index>(first_node, second_node), weight(weight) {};
 
-    public:
-        Edge() = default;
-        Edge(size_t first_node, size_t second_node, size_t weight) : Primitive_edge(first_node, second_node), weight(weight) {};
+    Weight get_weight() const;
 
-        size_t get_weight() const;
+    bool operator==(const Basic_edge& e) const;
+    bool operator!=(const Basic_edge& e) const;
+};
 
-        bool operator==(const Edge& e) const;
-        bool operator!=(const Edge& e) const;
-    };
+template<typename Index, typename Weight>
+class Basic_graph_as_vector
+{
+public:
+    typedef Index Index_type;
+    typedef Weight Weight_type;
+    typedef Basic_primitive_edge<Index> Primitive_edge;
+    typedef Basic_edge<Index, Weight> Edge;
+
+    static constexpr Index NODE_NUM_UDEF = std::numeric_limits<Index>::max();
+    static constexpr size_t RADIX_SORT_THRESHOLD = 256;
 
 private:
-    size_t node_num;
+    Index node_num;
     std::vector<Edge> graph;
 
 public:
-    enum {NODE_NUM_UDEF = INT_MAX};
-
-    Graph_as_vector(size_t node_num = NODE_NUM_UDEF, size_t edge_num = 0);
+    Basic_graph_as_vector(Index node_num = NODE_NUM_UDEF, size_t edge_num = 0);
 
-    void sort();
-    void add_edges(const Graph_as_vector& edges);
+    void sort(size_t thread_num = 1);
+    void add_edges(const Basic_graph_as_vector& edges);
     void add_edge(const Edge& edge);
-    void standartize();
+    void standartize(size_t thread_num = 1);
 
     size_t get_edge_num() const;
-    size_t get_node_num() const;
-    void set_node_num(size_t node_num_);
+    Index get_node_num() const;
+    void set_node_num(Index node_num_);
 
-    bool operator==(const Graph_as_vector& g) const;
-    bool operator!=(const Graph_as_vector& g) const;
+    bool operator==(const Basic_graph_as_vector& g) const;
+    bool operator!=(const Basic_graph_as_vector& g) const;
 
     const Edge& operator[](size_t i) const;
 };
 
-std::ostream& operator<<(std::ostream& stream, const Graph_as_vector& graph);
-std::istream& operator>>(std::istream& stream, Graph_as_vector& graph);
+typedef Basic_graph_as_vector<size_t, size_t> Graph_as_vector;
+
+template<typename Index, typename Weight>
+std::ostream& operator<<(std::ostream& stream, const Basic_graph_as_vector<Index, Weight>& graph);
+template<typename Index, typename Weight>
+std::istream& operator>>(std::istream& stream, Basic_graph_as_vector<Index, Weight>& graph);
 
 namespace std
 {
 
-template<>
-struct hash<Graph_as_vector::Primitive_edge>
+template<typename Index>
+struct hash<Basic_primitive_edge<Index>>
 {
-    size_t operator()(const Graph_as_vector::Primitive_edge& edge) const;
+    size_t operator()(const Basic_primitive_edge<Index>& edge) const;
 };
 
+template<typename Index>
+size_t hash<Basic_primitive_edge<Index>>::operator()(const Basic_primitive_edge<Index>& edge) const
+{
+    size_t first = hash<Index>()(edge.get_first_node()), second = hash<Index>()(edge.get_second_node());
+    return first * 0x9E3779B97F4A7C15ull ^ (second + (first << 6) + (first >> 2));
+}
+
+}
+
+template<typename Index>
+const Basic_primitive_edge<Index>& Basic_primitive_edge<Index>::standartize()
+{
+    if(first_node > second_node)
+        std::swap(first_node, second_node);
+
+    return *this;
+}
+
+template<typename Index>
+Index Basic_primitive_edge<Index>::get_first_node() const
+{
+    return first_node;
+}
+
+template<typename Index>
+Index Basic_primitive_edge<Index>::get_second_node() const
+{
+    return second_node;
+}
+
+template<typename Index>
+bool Basic_primitive_edge<Index>::operator==(const Basic_primitive_edge& e) const
+{
+    return first_node == e.first_node && second_node == e.second_node;
+}
+
+template<typename Index>
+bool Basic_primitive_edge<Index>::operator!=(const Basic_primitive_edge& e) const
+{
+    return !(*this == e);
+}
+
+template<typename Index, typename Weight>
+Weight Basic_edge<Index, Weight>::get_weight() const
+{
+    return weight;
+}
+
+template<typename Index, typename Weight>
+bool Basic_edge<Index, Weight>::operator==(const Basic_edge& e) const
+{
+    return Basic_primitive_edge<Index>::operator==(e) && weight == e.weight;
+}
+
+template<typename Index, typename Weight>
+bool Basic_edge<Index, Weight>::operator!=(const Basic_edge& e) const
+{
+    return !(*this == e);
+}
+
+template<typename Index, typename Weight>
+Basic_graph_as_vector<Index, Weight>::Basic_graph_as_vector(Index node_num, size_t edge_num) : node_num(node_num)
+{
+    graph.reserve(edge_num);
 }
 
+template<typename Index, typename Weight>
+void Basic_graph_as_vector<Index, Weight>::sort(size_t thread_num)
+{
+    if constexpr(std::is_integral<Weight>::value && std::is_unsigned<Index>::value)
+        if(graph.size() >= RADIX_SORT_THRESHOLD)
+        {
+            Index max_node = 0;
+            Weight min_weight = graph[0].get_weight(), max_weight = graph[0].get_weight();
+            for(const Edge& i : graph)
+            {
+                max_node = std::max(max_node, std::max(i.get_first_node(), i.get_second_node()));
+                min_weight = std::min(min_weight, i.get_weight());
+                max_weight = std::max(max_weight, i.get_weight());
+            }
+
+            typedef typename std::make_unsigned<Weight>::type Unsigned_weight;
+            unsigned char node_bits = bit_width(max_node);
+            unsigned char weight_bits = bit_width(static_cast<Unsigned_weight>(static_cast<Unsigned_weight>(max_weight) - static_cast<Unsigned_weight>(min_weight)));
+
+            if(2 * node_bits + weight_bits <= 64)
+            {
+                const size_t DIGIT_BITS = 11;
+                const unsigned long long node_mask = (1ull << node_bits) - 1;
+
+                std::vector<unsigned long long> keys(graph.size());
+                for(size_t i = 0; i < graph.size(); ++i)
+                {
+                    keys[i] = static_cast<Unsigned_weight>(static_cast<Unsigned_weight>(graph[i].get_weight()) - static_cast<Unsigned_weight>(min_weight));
+                    keys[i] = (((keys[i] << node_bits) | graph[i].get_second_node()) << node_bits) | graph[i].get_first_node();
+                }
+
+                radix_sort<DIGIT_BITS>(keys, (2 * node_bits + weight_bits + DIGIT_BITS - 1) / DIGIT_BITS, [](unsigned long long key, size_t d)
+                {
+                    return (key >> (d * DIGIT_BITS)) & ((1u << DIGIT_BITS) - 1);
+                }, thread_num);
+
+                for(size_t i = 0; i < graph.size(); ++i)
+                    graph[i] = Edge(static_cast<Index>(keys[i] & node_mask), static_cast<Index>((keys[i] >> node_bits) & node_mask),
+                                    static_cast<Weight>(static_cast<Unsigned_weight>(min_weight) + static_cast<Unsigned_weight>(keys[i] >> node_bits >> node_bits)));
+            }
+            else
+                radix_sort<CHAR_BIT>(graph, 2 * sizeof(Index) + sizeof(Weight), [](const Edge& e, size_t d)
+                {
+                    if(d < sizeof(Index))
+                        return key_byte(e.get_first_node(), d);
+                    else if(d < 2 * sizeof(Index))
+                        return key_byte(e.get_second_node(), d - sizeof(Index));
+                    else
+                        return key_byte(e.get_weight(), d - 2 * sizeof(Index));
+                }, thread_num);
+            return;
+        }
+
+    std::sort(graph.begin(), graph.end(), [](const Edge& a, const Edge& b)
+    {
+        if(a.get_weight() == b.get_weight())
+        {
+            if(a.get_second_node() == b.get_second_node())
+                return a.get_first_node() < b.get_first_node();
+            else
+                return a.get_second_node() < b.get_second_node();
+        }
+        else
+            return a.get_weight() < b.get_weight();
+    });
+}
+
+template<typename Index, typename Weight>
+void Basic_graph_as_vector<Index, Weight>::add_edges(const Basic_graph_as_vector& edges)
+{
+    graph.insert(graph.end(), edges.graph.begin(), edges.graph.end());
+}
+
+template<typename Index, typename Weight>
+void Basic_graph_as_vector<Index, Weight>::add_edge(const Edge& edge)
+{
+    graph.push_back(edge);
+}
+
+template<typename Index, typename Weight>
+void Basic_graph_as_vector<Index, Weight>::standartize(size_t thread_num)
+{
+    for(Edge& i : graph)
+        i.standartize();
+
+    sort(thread_num);
+
+    graph.erase(std::unique(graph.begin(), graph.end()), graph.end());
+}
+
+template<typename Index, typename Weight>
+size_t Basic_graph_as_vector<Index, Weight>::get_edge_num() const
+{
+    return graph.size();
+}
+
+template<typename Index, typename Weight>
+Index Basic_graph_as_vector<Index, Weight>::get_node_num() const
+{
+    return node_num;
+}
+
+template<typename Index, typename Weight>
+void Basic_graph_as_vector<Index, Weight>::set_node_num(Index node_num_)
+{
+    if(node_num == NODE_NUM_UDEF)
+        node_num = node_num_;
+    else
+        throw graph_as_vector_misuse();
+}
+
+template<typename Index, typename Weight>
+const typename Basic_graph_as_vector<Index, Weight>::Edge& Basic_graph_as_vector<Index, Weight>::operator[](size_t i) const
+{
+    return graph[i];
+}
+
+template<typename Index, typename Weight>
+bool Basic_graph_as_vector<Index, Weight>::operator==(const Basic_graph_as_vector& g) const
+{
+    return graph == g.graph;
+}
+
+template<typename Index, typename Weight>
+bool Basic_graph_as_vector<Index, Weight>::operator!=(const Basic_graph_as_vector& g) const
+{
+    return !(*this == g);
+}
+
+template<typename Index, typename Weight>
+std::ostream& operator<<(std::ostream& stream, const Basic_graph_as_vector<Index, Weight>& graph)
+{
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+        stream << graph[i].get_first_node() << " " << graph[i].get_second_node() << " " << graph[i].get_weight() << std::endl;
+    return stream;
+}
+
+template<typename Index, typename Weight>
+std::istream& operator>>(std::istream& stream, Basic_graph_as_vector<Index, Weight>& graph)
+{
+    Index node_num;
+    size_t edge_num;
+    stream >> node_num >> edge_num;
+
+    graph.set_node_num(node_num);
+
+    Index first_node, second_node;
+    Weight weight;
+    for(size_t i = 0; i < edge_num; ++i)
+    {
+        stream >> first_node >> second_node >> weight;
+        graph.add_edge(typename Basic_graph_as_vector<Index, Weight>::Edge(first_node, second_node, weight));
+    }
+
+    return stream;
+}
+
+extern template class Basic_graph_as_vector<size_t, size_t>;
+
 #endif // GRAPH_AS_VECTOR_H_INCLUDED
@@ -2,22 +2,115 @@
 #define KRUSKAL_H_INCLUDED
 
 #include <vector>
-#include <unordered_map>
+#include <limits>
+#include <algorithm>
 
 #include "graph_as_vector.h"
 
-class Dsu
+template<typename Index>
+class Basic_dsu
 {
 private:
-    std::unordered_map<int, int> parent, rank;
+    static constexpr Index UDEF = std::numeric_limits<Index>::max();
+
+    std::vector<Index> parent;
+    std::vector<unsigned char> rank;
 
 public:
-    void make_set(int v);
-    int find_set(int v);
-    void union_sets(int a, int b);
-    bool node_in_dsu(int v) const;
+    void make_set(Index v);
+    Index find_set(Index v);
+    void union_sets(Index a, Index b);
+    bool node_in_dsu(Index v) const;
 };
 
-Graph_as_vector mst(Graph_as_vector graph);
+typedef Basic_dsu<size_t> Dsu;
+
+template<typename Index, typename Weight, typename Visitor>
+void kruskal_sweep(Basic_graph_as_vector<Index, Weight> graph, Visitor visit, size_t thread_num = 1);
+template<typename Index, typename Weight>
+Basic_graph_as_vector<Index, Weight> mst(Basic_graph_as_vector<Index, Weight> graph, size_t thread_num = 1);
+
+template<typename Index>
+void Basic_dsu<Index>::make_set(Index v)
+{
+    if(v >= parent.size())
+    {
+        parent.resize(v + 1, UDEF);
+        rank.resize(v + 1, 0);
+    }
+    parent[v] = v;
+    rank[v] = 0;
+}
+
+template<typename Index>
+Index Basic_dsu<Index>::find_set(Index v)
+{
+    while(v != parent[v])
+    {
+        parent[v] = parent[parent[v]];
+        v = parent[v];
+    }
+    return v;
+}
+
+template<typename Index>
+void Basic_dsu<Index>::union_sets(Index a, Index b)
+{
+    a = find_set(a);
+    b = find_set(b);
+    if(a != b)
+    {
+        if(rank[a] < rank[b])
+            std::swap(a, b);
+        parent[b] = a;
+        if(rank[a] == rank[b])
+            rank[a]++;
+    }
+}
+
+template<typename Index>
+bool Basic_dsu<Index>::node_in_dsu(Index v) const
+{
+    return v < parent.size() && parent[v] != UDEF;
+}
+
+template<typename Index, typename Weight, typename Visitor>
+void kruskal_sweep(Basic_graph_as_vector<Index, Weight> graph, Visitor visit, size_t thread_num)
+{
+    Basic_dsu<Index> dsu;
+
+    graph.sort(thread_num);
+
+    for(Index i = 0; i < graph.get_node_num(); i++)
+        dsu.make_set(i);
+
+    for(size_t i = 0, merge_num = 0; i < graph.get_edge_num() && merge_num < graph.get_node_num(); ++i)
+    {
+        Index first = dsu.find_set(graph[i].get_first_node()), second = dsu.find_set(graph[i].get_second_node());
+        if(first != second)
+        {
+            dsu.union_sets(first, second);
+            visit(graph[i], first, second, dsu.find_set(first));
+            ++merge_num;
+        }
+    }
+}
+
+template<typename Index, typename Weight>
+Basic_graph_as_vector<Index, Weight> mst(Basic_graph_as_vector<Index, Weight> graph, size_t thread_num)
+{
+    Basic_graph_as_vector<Index, Weight> result;
+
+    kruskal_sweep(std::move(graph), [&result](const Basic_edge<Index, Weight>& edge, Index, Index, Index)
+    {
+        result.add_edge(edge);
+    }, thread_num);
+
+    result.standartize(thread_num);
+    return result;
+}
+
+extern template class Basic_dsu<size_t>;
+extern template Graph_as_vector mst(Graph_as_vector graph, size_t thread_num);
 
 #endif // KRUSKAL_H_INCLUDED
@@ -0,0 +1,169 @@
+#include <vector>
+#include <utility>
+
+#include "link_cut_tree.h"
+
+Link_cut_tree::Link_cut_tree(size_t vertex_num)
+{
+    tree.reserve(vertex_num);
+    for(size_t i = 0; i < vertex_num; ++i)
+        add_vertex();
+}
+
+size_t Link_cut_tree::add_vertex(size_t weight)
+{
+    tree.push_back(Vertex{{NIL, NIL}, NIL, weight, NIL, false});
+    pull(tree.size() - 1);
+    return tree.size() - 1;
+}
+
+bool Link_cut_tree::heavier(size_t a, size_t b) const
+{
+    if(b == NIL)
+        return a != NIL;
+    if(a == NIL)
+        return false;
+    if(tree[a].weight != tree[b].weight)
+        return tree[a].weight > tree[b].weight;
+    return a > b;
+}
+
+bool Link_cut_tree::is_root(size_t v) const
+{
+    size_t p = tree[v].parent;
+    return p == NIL || (tree[p].child[0] != v && tree[p].child[1] != v);
+}
+
+void Link_cut_tree::push(size_t v)
+{
+    if(!tree[v].flip)
+        return;
+
+    std::swap(tree[v].child[0], tree[v].child[1]);
+    for(size_t c : tree[v].child)
+        if(c != NIL)
+            tree[c].flip = !tree[c].flip;
+    tree[v].flip = false;
+}
+
+void Link_cut_tree::pull(size_t v)
+{
+    tree[v].max = tree[v].weight == NIL ? NIL : v;
+    for(size_t c : tree[v].child)
+        if(c != NIL && heavier(tree[c].max, tree[v].max))
+            tree[v].max = tree[c].max;
+}
+
+void Link_cut_tree::rotate(size_t v)
+{
+    size_t p = tree[v].parent, g = tree[p].parent;
+    bool side = tree[p].child[1] == v;
+
+    if(!is_root(p))
+        tree[g].child[tree[g].child[1] == p] = v;
+    tree[v].parent = g;
+
+    tree[p].child[side] = tree[v].child[!side];
+    if(tree[v].child[!side] != NIL)
+        tree[tree[v].child[!side]].parent = p;
+
+    tree[v].child[!side] = p;
+    tree[p].parent = v;
+
+    pull(p);
+    pull(v);
+}
+
+void Link_cut_tree::splay(size_t v)
+{
+    path.assign(1, v);
+    for(size_t i = v; !is_root(i); i = tree[i].parent)
+        path.push_back(tree[i].parent);
+    for(size_t i = path.size(); i-- > 0;)
+        push(path[i]);
+
+    while(!is_root(v))
+    {
+        size_t p = tree[v].parent;
+        if(!is_root(p))
+        {
+            size_t g = tree[p].parent;
+            if((tree[g].child[0] == p) == (tree[p].child[0] == v))
+                rotate(p);
+            else
+                rotate(v);
+        }
+        rotate(v);
+    }
+}
+
+void Link_cut_tree::access(size_t v)
+{
+    size_t last = NIL;
+    for(size_t i = v; i != NIL; i = tree[i].parent)
+    {
+        splay(i);
+        tree[i].child[1] = last;
+        pull(i);
+        last = i;
+    }
+    splay(v);
+}
+
+void Link_cut_tree::make_root(size_t v)
+{
+    access(v);
+    tree[v].flip = !tree[v].flip;
+    push(v);
+}
+
+size_t Link_cut_tree::find_root(size_t v)
+{
+    access(v);
+    while(true)
+    {
+        push(v);
+        if(tree[v].child[0] == NIL)
+            break;
+        v = tree[v].child[0];
+    }
+    splay(v);
+    return v;
+}
+
+void Link_cut_tree::set_weight(size_t v, size_t weight)
+{
+    access(v);
+    tree[v].weight = weight;
+    pull(v);
+}
+
+void Link_cut_tree::link(size_t u, size_t v)
+{
+    make_root(u);
+    tree[u].parent = v;
+}
+
+void Link_cut_tree::cut(size_t u, size_t v)
+{
+    make_root(u);
+    access(v);
+    if(tree[v].child[0] == u && tree[u].child[0] == NIL && tree[u].child[1] == NIL)
+    {
+        tree[v].child[0] = NIL;
+        tree[u].parent = NIL;
+        pull(v);
+    }
+}
+
+bool Link_cut_tree::connected(size_t u, size_t v)
+{
+    return u == v || find_root(u) == find_root(v);
+}
+
+size_t Link_cut_tree::path_max(size_t u, size_t v)
+{
+    make_root(u);
+    access(v);
+    return tree[v].max;
+}
@@ -0,0 +1,45 @@
+#ifndef LINK_CUT_TREE_H_INCLUDED
+#define LINK_CUT_TREE_H_INCLUDED
+
+#include <cstddef>
+#include <vector>
+#include <limits>
+
+class Link_cut_tree
+{
+public:
+    static constexpr size_t NIL = std::numeric_limits<size_t>::max();
+
+private:
+    struct Vertex
+    {
+        size_t child[2], parent, weight, max;
+        bool flip;
+    };
+
+    std::vector<Vertex> tree;
+    std::vector<size_t> path;
+
+    bool heavier(size_t a, size_t b) const;
+    bool is_root(size_t v) const;
+    void push(size_t v);
+    void pull(size_t v);
+    void rotate(size_t v);
+    void splay(size_t v);
+    void access(size_t v);
+    void make_root(size_t v);
+    size_t find_root(size_t v);
+
+public:
+    Link_cut_tree(size_t vertex_num = 0);
+
+    size_t add_vertex(size_t weight = NIL);
+    void set_weight(size_t v, size_t weight);
+
+    void link(size_t u, size_t v);
+    void cut(size_t u, size_t v);
+    bool connected(size_t u, size_t v);
+    size_t path_max(size_t u, size_t v);
+};
+
+#endif // LINK_CUT_TREE_H_INCLUDED
@@ -0,0 +1,134 @@
+#ifndef MAILBOX_H_INCLUDED
+#define MAILBOX_H_INCLUDED
+
+#include <cstddef>
+#include <vector>
+#include <limits>
+#include <utility>
+
+template<typename T>
+class Mailbox
+{
+public:
+    static constexpr size_t NIL = std::numeric_limits<size_t>::max();
+
+private:
+    struct Slot
+    {
+        T value;
+        size_t next;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<size_t> heads, tails;
+    size_t free_slot, in_flight;
+
+public:
+    Mailbox(size_t box_num = 0);
+
+    void resize(size_t box_num);
+    size_t box_num() const;
+
+    bool empty() const;
+    bool empty(size_t box) const;
+    size_t size() const;
+    size_t length(size_t box) const;
+
+    const T& front(size_t box) const;
+    void push_back(size_t box, T value);
+    void pop_front(size_t box);
+};
+
+template<typename T>
+Mailbox<T>::Mailbox(size_t box_num) : heads(box_num, NIL), tails(box_num, NIL), free_slot(NIL), in_flight(0)
+{
+}
+
+template<typename T>
+void Mailbox<T>::resize(size_t box_num)
+{
+    heads.resize(box_num, NIL);
+    tails.resize(box_num, NIL);
+}
+
+template<typename T>
+size_t Mailbox<T>::box_num() const
+{
+    return heads.size();
+}
+
+template<typename T>
+bool Mailbox<T>::empty() const
+{
+    return in_flight == 0;
+}
+
+template<typename T>
+bool Mailbox<T>::empty(size_t box) const
+{
+    return heads[box] == NIL;
+}
+
+template<typename T>
+size_t Mailbox<T>::size() const
+{
+    return in_flight;
+}
+
+template<typename T>
+size_t Mailbox<T>::length(size_t box) const
+{
+    size_t result = 0;
+    for(size_t i = heads[box]; i != NIL; i = slots[i].next)
+        ++result;
+    return result;
+}
+
+template<typename T>
+const T& Mailbox<T>::front(size_t box) const
+{
+    return slots[heads[box]].value;
+}
+
+template<typename T>
+void Mailbox<T>::push_back(size_t box, T value)
+{
+    size_t slot = free_slot;
+    if(slot == NIL)
+    {
+        slot = slots.size();
+        slots.push_back(Slot{std::move(value), NIL});
+    }
+    else
+    {
+        free_slot = slots[slot].next;
+        slots[slot].value = std::move(value);
+        slots[slot].next = NIL;
+    }
+
+    if(tails[box] == NIL)
+        heads[box] = slot;
+    else
+        slots[tails[box]].next = slot;
+    tails[box] = slot;
+
+    ++in_flight;
+}
+
+template<typename T>
+void Mailbox<T>::pop_front(size_t box)
+{
+    size_t slot = heads[box];
+
+    heads[box] = slots[slot].next;
+    if(heads[box] == NIL)
+        tails[box] = NIL;
+
+    slots[slot].value = T();
+    slots[slot].next = free_slot;
+    free_slot = slot;
+
+    --in_flight;
+}
+
+#endif // MAILBOX_H_INCLUDED
@@ -2,15 +2,41 @@
 #include <sstream>
 #include <cmath>
 #include <utility>
+#include <fstream>
+#include <limits>
+#include <chrono>
 
 #include "graph_as_vector.h"
 #include "emulator.h"
 #include "kruskal.h"
+#include "compact_ghs.h"
+#include "compressed_graph.h"
+#include "dendrogram.h"
+#include "external_mst.h"
+#include "mst_cache.h"
+#include "renumbering.h"
+#include "static_node.h"
+#include "batch.h"
+#include "explorer.h"
 #include "node.h"
+#include "trace.h"
+#include "profile.h"
 #include "random"
 
 //#define TEST
 //#define GENERATE_PRIMITIVE_TEST
+//#define COMPACT_ENGINE
+//#define STATIC_ENGINE
+//#define EXPLORE_SCHEDULES
+//#define RECORD_TRACE
+//#define COMPARE_PROTOCOLS
+//#define EXTERNAL_MST
+//#define RENUMBER_NODES
+//#define BATCH_MODE
+//#define COMPRESSED_STORAGE
+//#define REPORT_PROGRESS
+//#define CACHE_RESULTS
+//#define SINGLE_LINKAGE
 
 int main()
 {
@@ -18,6 +44,12 @@ int main()
     freopen("input.txt", "r", stdin);
 #endif // TEST
 
+#ifdef BATCH_MODE
+    std::ios::sync_with_stdio(false);
+    process_batch(std::cin, std::cout);
+    return 0;
+#endif // BATCH_MODE
+
 #ifndef GENERATE_PRIMITIVE_TEST
     std::istream& stream = std::cin;
 #endif
@@ -52,7 +84,89 @@ int main()
 
     stream >> g;
 
+#if defined(RECORD_TRACE)
+    {
+        Trace_writer writer("trace.bin", g.get_node_num());
+        Ghs_options options;
+        options.trace = &writer;
+        std::cout << (ghs(g, options) == mst(g));
+    }
+    {
+        Trace_reader reader("trace.bin");
+        Ghs_options options;
+        options.replay = &reader;
+        std::cout << (ghs(g, options) == mst(g));
+    }
+    {
+        Trace_reader reader("trace.bin");
+        std::ofstream json("trace.json");
+        export_chrome_trace(reader, json);
+    }
+#elif defined(COMPARE_PROTOCOLS)
+    std::cout << "GHS" << std::endl << explore(g, 100, 0, 0, GHS_PROTOCOL)
+              << "GKP" << std::endl << explore(g, 100, 0, 0, GKP_PROTOCOL)
+              << "Boruvka" << std::endl << explore(g, 100, 0, 0, BORUVKA_PROTOCOL);
+#elif defined(EXTERNAL_MST)
+    std::cout << (semi_external_mst("input.txt", ".") == mst(g));
+    {
+        Graph_as_vector tree(g.get_node_num(), external_mst("input.txt", "output.txt", ".", 3));
+        std::ifstream output("output.txt");
+        size_t first_node, second_node, weight;
+        while(output >> first_node >> second_node >> weight)
+            tree.add_edge(Graph_as_vector::Edge(first_node, second_node, weight));
+        tree.standartize();
+        std::cout << (tree == mst(g));
+    }
+#elif defined(RENUMBER_NODES)
+    const Graph_as_vector reference = mst(g);
+    const char* const names[] = {"none", "bfs", "rcm", "degree"};
+    for(size_t i = 0; i < 4; ++i)
+    {
+        std::cout << names[i];
+        for(size_t j = 0; j < 3; ++j)
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            Graph_as_vector result = i == 0 ? (j == 0 ? mst(g) : j == 1 ? compact_ghs(g) : ghs(g))
+                                            : renumbered(g, Renumbering_strategy(i - 1), [j](const Graph_as_vector& h)
+            {
+                return j == 0 ? mst(h) : j == 1 ? compact_ghs(h) : ghs(h);
+            });
+            std::cout << " " << (result == reference) << " "
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() << "ms";
+        }
+        std::cout << std::endl;
+    }
+#elif defined(COMPRESSED_STORAGE)
+    const Compressed_graph c(g);
+    std::cout << (mst(c) == mst(g)) << " " << (ghs(c) == mst(g)) << " "
+              << c.get_memory() << " " << g.get_edge_num() * sizeof(Graph_as_vector::Edge) << std::endl;
+#elif defined(REPORT_PROGRESS)
+    Ghs_options options;
+    options.progress = [](const Emulator_progress& progress)
+    {
+        std::cerr << progress << std::endl;
+    };
+    options.progress_interval = 1000;
+    options.livelock_rounds = 100000;
+    std::cout << (ghs(g, options) == mst(g));
+#elif defined(CACHE_RESULTS)
+    Mst_cache cache("mst_cache");
+    std::cout << (ghs(g, cache) == mst(g)) << (ghs(g, cache) == mst(g));
+#elif defined(SINGLE_LINKAGE)
+    std::cout << Dendrogram(g);
+#elif defined(EXPLORE_SCHEDULES)
+    std::cout << explore(g, 1000);
+#elif defined(STATIC_ENGINE)
+    std::cout << (static_ghs(g) == mst(g));
+#elif defined(COMPACT_ENGINE)
+    std::cout << (compact_ghs(g) == mst(g));
+#else
     std::cout << (ghs(g) == mst(g));
+#endif
+
+#ifdef PROFILE_HANDLERS
+    std::cerr << std::endl << take_handler_profile();
+#endif // PROFILE_HANDLERS
 
     return 0;
 }
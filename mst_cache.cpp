@@ -0,0 +1,336 @@
+#include <string>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <cctype>
+#include <cstdio>
+
+#include "mst_cache.h"
+#include "graph_as_vector.h"
+#include "kruskal.h"
+#include "ghs.h"
+
+namespace
+{
+
+const char MAGIC[] = {'M', 'S', 'T', 'C'};
+const char* const EXTENSION = ".mst";
+
+size_t mix(size_t x)
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+void put_varint(std::ostream& stream, size_t value)
+{
+    for(; value >= 0x80; value >>= 7)
+        stream.put(static_cast<char>(value | 0x80));
+    stream.put(static_cast<char>(value));
+}
+
+size_t get_varint(std::istream& stream)
+{
+    size_t result = 0;
+    for(size_t shift = 0; ; shift += 7)
+    {
+        int byte = stream.get();
+        if(byte == std::char_traits<char>::eof() || shift >= 64)
+            throw bad_mst_cache();
+
+        result |= static_cast<size_t>(byte & 0x7f) << shift;
+        if((byte & 0x80) == 0)
+            return result;
+    }
+}
+
+std::string sanitize(const std::string& tag)
+{
+    std::string result = tag;
+    for(char& i : result)
+        if(!std::isalnum(static_cast<unsigned char>(i)))
+            i = '-';
+    return result;
+}
+
+}
+
+std::string Mst_key::to_string() const
+{
+    char buffer[4 * 16 + 4];
+    std::snprintf(buffer, sizeof(buffer), "%zx-%zx-%016zx%016zx", node_num, edge_num, first_hash, second_hash);
+    return buffer;
+}
+
+Mst_cache::Mst_cache(const std::string& directory, size_t capacity, bool verify) : directory(directory), capacity(capacity), size(0), hit_num(0), miss_num(0), verify(verify)
+{
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if(!std::filesystem::is_directory(directory, error))
+        throw bad_mst_cache();
+
+    std::vector<std::tuple<std::filesystem::file_time_type, std::string, size_t>> found;
+    for(const std::filesystem::directory_entry& i : std::filesystem::directory_iterator(directory, error))
+        if(i.is_regular_file(error) && i.path().extension() == EXTENSION)
+            found.emplace_back(i.last_write_time(error), i.path().filename().string(), i.file_size(error));
+
+    std::sort(found.begin(), found.end());
+    for(const std::tuple<std::filesystem::file_time_type, std::string, size_t>& i : found)
+    {
+        order.push_back(std::get<1>(i));
+        entries[std::get<1>(i)] = std::make_pair(std::get<2>(i), std::prev(order.end()));
+        size += std::get<2>(i);
+    }
+
+    evict();
+}
+
+std::string Mst_cache::get_path(const std::string& name) const
+{
+    return directory + "/" + name;
+}
+
+bool Mst_cache::load(const std::string& name, const Mst_key& key, const Graph_as_vector& graph, Graph_as_vector& result) const
+{
+    std::ifstream stream(get_path(name), std::ios::binary);
+
+    try
+    {
+        for(char i : MAGIC)
+            if(stream.get() != i)
+                return false;
+
+        Mst_key stored;
+        stored.node_num = get_varint(stream);
+        stored.edge_num = get_varint(stream);
+        stored.first_hash = get_varint(stream);
+        stored.second_hash = get_varint(stream);
+        if(std::tie(stored.node_num, stored.edge_num, stored.first_hash, stored.second_hash) != std::tie(key.node_num, key.edge_num, key.first_hash, key.second_hash))
+            return false;
+
+        size_t edge_num = get_varint(stream), weight = 0;
+        result = Graph_as_vector(key.node_num, edge_num);
+        for(size_t i = 0; i < edge_num; ++i)
+        {
+            size_t first_node = get_varint(stream), second_node = get_varint(stream);
+            weight += get_varint(stream);
+            result.add_edge(Graph_as_vector::Edge(first_node, second_node, weight));
+        }
+    }
+    catch(const bad_mst_cache&)
+    {
+        return false;
+    }
+
+    return !verify || is_spanning_forest(graph, result);
+}
+
+void Mst_cache::store(const std::string& name, const Mst_key& key, const Graph_as_vector& result)
+{
+    Graph_as_vector sorted = result;
+    sorted.standartize();
+
+    std::string path = get_path(name), temp_path = path + ".tmp";
+    {
+        std::ofstream stream(temp_path, std::ios::binary);
+        stream.write(MAGIC, sizeof(MAGIC));
+        for(size_t i : {key.node_num, key.edge_num, key.first_hash, key.second_hash, sorted.get_edge_num()})
+            put_varint(stream, i);
+
+        size_t weight = 0;
+        for(size_t i = 0; i < sorted.get_edge_num(); ++i)
+        {
+            put_varint(stream, sorted[i].get_first_node());
+            put_varint(stream, sorted[i].get_second_node());
+            put_varint(stream, sorted[i].get_weight() - weight);
+            weight = sorted[i].get_weight();
+        }
+
+        if(!stream.flush())
+        {
+            std::remove(temp_path.c_str());
+            return;
+        }
+    }
+
+    if(entries.count(name))
+        erase(name);
+
+    std::error_code error;
+    std::filesystem::rename(temp_path, path, error);
+    if(error)
+    {
+        std::remove(temp_path.c_str());
+        return;
+    }
+
+    order.push_back(name);
+    entries[name] = std::make_pair(std::filesystem::file_size(path, error), std::prev(order.end()));
+    size += entries[name].first;
+}
+
+void Mst_cache::touch(const std::string& name)
+{
+    order.splice(order.end(), order, entries[name].second);
+
+    std::error_code error;
+    std::filesystem::last_write_time(get_path(name), std::filesystem::file_time_type::clock::now(), error);
+}
+
+void Mst_cache::erase(std::string name)
+{
+    std::remove(get_path(name).c_str());
+
+    size -= entries[name].first;
+    order.erase(entries[name].second);
+    entries.erase(name);
+}
+
+void Mst_cache::evict()
+{
+    while(size > capacity && !order.empty())
+        erase(order.front());
+}
+
+Graph_as_vector Mst_cache::compute(const Graph_as_vector& graph, const std::string& tag, const Engine& engine)
+{
+    Mst_key key = mst_key(graph);
+    std::string name = sanitize(tag) + "_" + key.to_string() + EXTENSION;
+
+    bool found;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        found = entries.count(name) != 0;
+    }
+
+    if(found)
+    {
+        Graph_as_vector result;
+        bool loaded = load(name, key, graph, result);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if(loaded)
+        {
+            if(entries.count(name))
+                touch(name);
+            ++hit_num;
+            return result;
+        }
+
+        if(entries.count(name))
+            erase(name);
+    }
+    ++miss_num;
+
+    Graph_as_vector result = engine(graph);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    store(name, key, result);
+    evict();
+
+    return result;
+}
+
+void Mst_cache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    while(!order.empty())
+        erase(order.front());
+}
+
+size_t Mst_cache::get_hit_num() const
+{
+    return hit_num;
+}
+
+size_t Mst_cache::get_miss_num() const
+{
+    return miss_num;
+}
+
+size_t Mst_cache::get_size() const
+{
+    return size;
+}
+
+Mst_key mst_key(const Graph_as_vector& graph)
+{
+    Mst_key key{graph.get_node_num(), graph.get_edge_num(), 0, 0};
+
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+    {
+        Graph_as_vector::Primitive_edge e(graph[i]);
+        e.standartize();
+
+        size_t h = mix(mix(mix(e.get_first_node()) + e.get_second_node()) + graph[i].get_weight());
+        key.first_hash += h;
+        key.second_hash += mix(h + 0x632BE59BD9B4E019ull);
+    }
+
+    return key;
+}
+
+bool is_spanning_forest(const Graph_as_vector& graph, const Graph_as_vector& forest)
+{
+    std::unordered_map<Graph_as_vector::Primitive_edge, std::pair<size_t, bool>> edges;
+    Dsu forest_dsu, graph_dsu;
+    for(size_t i = 0; i < graph.get_node_num(); ++i)
+    {
+        forest_dsu.make_set(i);
+        graph_dsu.make_set(i);
+    }
+
+    for(size_t i = 0; i < forest.get_edge_num(); ++i)
+    {
+        size_t first = forest[i].get_first_node(), second = forest[i].get_second_node();
+        if(first >= graph.get_node_num() || second >= graph.get_node_num() || forest_dsu.find_set(first) == forest_dsu.find_set(second))
+            return false;
+
+        forest_dsu.union_sets(first, second);
+        edges[Graph_as_vector::Primitive_edge(forest[i]).standartize()] = std::make_pair(forest[i].get_weight(), false);
+    }
+
+    size_t components = graph.get_node_num(), matched = 0;
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+    {
+        if(graph_dsu.find_set(graph[i].get_first_node()) != graph_dsu.find_set(graph[i].get_second_node()))
+        {
+            graph_dsu.union_sets(graph[i].get_first_node(), graph[i].get_second_node());
+            --components;
+        }
+
+        std::unordered_map<Graph_as_vector::Primitive_edge, std::pair<size_t, bool>>::iterator j = edges.find(Graph_as_vector::Primitive_edge(graph[i]).standartize());
+        if(j != edges.end() && !j->second.second && j->second.first == graph[i].get_weight())
+        {
+            j->second.second = true;
+            ++matched;
+        }
+    }
+
+    return matched == forest.get_edge_num() && forest.get_edge_num() + components == graph.get_node_num();
+}
+
+Graph_as_vector mst(const Graph_as_vector& graph, Mst_cache& cache)
+{
+    return cache.compute(graph, "kruskal", [](const Graph_as_vector& g)
+    {
+        return mst(g);
+    });
+}
+
+Graph_as_vector ghs(const Graph_as_vector& graph, Mst_cache& cache)
+{
+    return cache.compute(graph, "ghs", [](const Graph_as_vector& g)
+    {
+        return ghs(g);
+    });
+}
@@ -0,0 +1,67 @@
+#ifndef MST_CACHE_H_INCLUDED
+#define MST_CACHE_H_INCLUDED
+
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include <atomic>
+#include <utility>
+#include <stdexcept>
+
+#include "graph_as_vector.h"
+
+class bad_mst_cache : public std::exception
+{
+};
+
+struct Mst_key
+{
+    size_t node_num, edge_num, first_hash, second_hash;
+
+    std::string to_string() const;
+};
+
+class Mst_cache
+{
+public:
+    typedef std::function<Graph_as_vector(const Graph_as_vector&)> Engine;
+
+    static constexpr size_t DEFAULT_CAPACITY = size_t(1) << 30;
+
+private:
+    std::string directory;
+    size_t capacity;
+    std::atomic<size_t> size, hit_num, miss_num;
+    bool verify;
+
+    std::list<std::string> order;
+    std::unordered_map<std::string, std::pair<size_t, std::list<std::string>::iterator>> entries;
+    std::mutex mutex;
+
+    std::string get_path(const std::string& name) const;
+    bool load(const std::string& name, const Mst_key& key, const Graph_as_vector& graph, Graph_as_vector& result) const;
+    void store(const std::string& name, const Mst_key& key, const Graph_as_vector& result);
+    void touch(const std::string& name);
+    void erase(std::string name);
+    void evict();
+
+public:
+    Mst_cache(const std::string& directory, size_t capacity = DEFAULT_CAPACITY, bool verify = true);
+
+    Graph_as_vector compute(const Graph_as_vector& graph, const std::string& tag, const Engine& engine);
+    void clear();
+
+    size_t get_hit_num() const;
+    size_t get_miss_num() const;
+    size_t get_size() const;
+};
+
+Mst_key mst_key(const Graph_as_vector& graph);
+bool is_spanning_forest(const Graph_as_vector& graph, const Graph_as_vector& forest);
+
+Graph_as_vector mst(const Graph_as_vector& graph, Mst_cache& cache);
+Graph_as_vector ghs(const Graph_as_vector& graph, Mst_cache& cache);
+
+#endif // MST_CACHE_H_INCLUDED
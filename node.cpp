@@ -7,6 +7,7 @@
 
 #include "node.h"
 #include "emulator.h"
+#include "profile.h"
 
 size_t Edge::get_end() const
 {
@@ -31,7 +32,7 @@ Edge::Edge(size_t end, State state, size_t weight) : end(end), weight(weight), s
 {
 }
 
-Node::Node() : state(Node::SLEEP), checking_postponed(false), component(Edge::UDEF, 0)
+Node::Node() : best_edge_weight(Edge::INF_WEIGHT), best_edge(Edge::UDEF), test_node(Node::UDEF), reports(0), level_cap(Node::UDEF), branch_num(0), rejected_num(0), state(Node::SLEEP), checking_postponed(false), core_moved(false), component(Edge::UDEF, 0)
 {
 }
 
@@ -51,6 +52,32 @@ const std::deque<std::shared_ptr<const Emulator_query>>& Node::wake_up()
     return tick(std::make_shared<WAKE_UP>(id, id));
 }
 
+void Node::seed(const Component& component_, State state_)
+{
+    component = component_;
+    state = state_;
+}
+
+void Node::set_edge_state(size_t end, Edge::State state_)
+{
+    mark_edge(get_edge(end), state_);
+}
+
+void Node::set_level_cap(size_t level_cap_)
+{
+    level_cap = level_cap_;
+}
+
+const Component& Node::get_component() const
+{
+    return component;
+}
+
+size_t Node::get_level_cap() const
+{
+    return level_cap;
+}
+
 Graph_as_vector Node::get_branches() const
 {
     Graph_as_vector result;
@@ -67,8 +94,39 @@ bool Node::ended() const
     return state == Node::END;
 }
 
+unsigned char Node::get_state() const
+{
+    return state;
+}
+
+size_t Node::get_priority() const
+{
+    return component.level;
+}
+
+size_t Node::get_fragment() const
+{
+    return component.fragment;
+}
+
+size_t Node::get_signature() const
+{
+    size_t signature = Emulator_node::get_signature();
+    for(size_t i : {parent, component.level, test_node, best_edge, reports, branch_num, rejected_num, postponed.size(), size_t(core_moved)})
+        signature = mix_signature(signature, i);
+
+    return signature;
+}
+
+size_t Node::get_phase_num() const
+{
+    return component.level + 1;
+}
+
 size_t Node::get_edge(size_t end) const
 {
+    PROFILE(PROFILE_GET_EDGE);
+
     return std::distance(edges.begin(), find_if(edges.begin(), edges.end(), [end](const Edge& e)
     {
         return e.get_end() == end;
@@ -77,6 +135,8 @@ size_t Node::get_edge(size_t end) const
 
 size_t Node::find_min_edge() const
 {
+    PROFILE(PROFILE_FIND_MIN_EDGE);
+
     std::pair<size_t, size_t> min(Edge::UDEF, Edge::INF_WEIGHT);
     for(size_t i = 0; i < edges.size(); ++i)
         if(edges[i].get_state() == Edge::UNKNOWN && edges[i].get_weight() < min.second)
@@ -87,11 +147,41 @@ size_t Node::find_min_edge() const
     return min.first;
 }
 
+void Node::mark_edge(size_t i, Edge::State state_)
+{
+    if(edges[i].state == Edge::BRANCH)
+        --branch_num;
+    else if(edges[i].state == Edge::REJECTED)
+        --rejected_num;
+
+    if(state_ == Edge::BRANCH)
+        ++branch_num;
+    else if(state_ == Edge::REJECTED)
+        ++rejected_num;
+
+    edges[i].state = state_;
+}
+
 void Node::send(std::shared_ptr<const Query> q)
 {
     result.push_back(q);
 }
 
+void Node::send(std::vector<size_t> recipients, std::shared_ptr<const Query> q)
+{
+    result.push_back(std::make_shared<Emulator_multicast>(std::move(recipients), std::move(q)));
+}
+
+std::vector<size_t> Node::get_children() const
+{
+    std::vector<size_t> children;
+    for(const Edge& i : edges)
+        if(i.get_state() == Edge::BRANCH && i.get_end() != parent)
+            children.push_back(i.get_end());
+
+    return children;
+}
+
 void Node::postpone(std::shared_ptr<const Query> q)
 {
     postponed.push(q);
@@ -99,6 +189,8 @@ void Node::postpone(std::shared_ptr<const Query> q)
 
 void Node::check_postponed()
 {
+    PROFILE(PROFILE_CHECK_POSTPONED);
+
     if(checking_postponed)
         return;
 
@@ -144,11 +236,14 @@ void Node::report()
 void Node::change_core()
 {
     if(edges[best_edge].get_state() == Edge::BRANCH)
+    {
+        core_moved = true;
         send(std::make_shared<CHANGE_CORE>(id, edges[best_edge].get_end()));
+    }
     else
     {
         send(std::make_shared<CONNECT>(id, edges[best_edge].get_end(), component));
-        edges[best_edge].state = Edge::BRANCH;
+        mark_edge(best_edge, Edge::BRANCH);
 
         check_postponed();
     }
@@ -168,15 +263,18 @@ const std::deque<std::shared_ptr<const Emulator_query>>& Node::tick(std::shared_
 
 void Node::visit(const INIT& q)
 {
+    PROFILE(PROFILE_INIT);
+
     component = q.component;
     state = q.state;
     parent = q.get_sender();
+    core_moved = false;
     best_edge = Edge::UDEF;
     best_edge_weight = Edge::INF_WEIGHT;
 
-    for(const Edge& i : edges)
-        if(i.get_state() == Edge::BRANCH && i.get_end() != parent)
-            send(std::make_shared<INIT>(id, i.get_end(), q.component, q.state));
+    std::vector<size_t> children = get_children();
+    if(!children.empty())
+        send(std::move(children), std::make_shared<INIT>(id, Emulator_query::MULTICAST, q.component, q.state));
 
     if(state == Node::SEARCH)
     {
@@ -189,35 +287,43 @@ void Node::visit(const INIT& q)
 
 void Node::visit(const CHANGE_CORE& q)
 {
+    PROFILE(PROFILE_CHANGE_CORE);
+
     change_core();
 }
 
 void Node::visit(const CONNECT& q)
 {
+    PROFILE(PROFILE_CONNECT);
+
     size_t connect_edge = get_edge(q.get_sender());
     if(q.component.level < component.level)
     {
-        edges[connect_edge].state = Edge::BRANCH;
+        mark_edge(connect_edge, Edge::BRANCH);
 
         send(std::make_shared<INIT>(id, q.get_sender(), component, state));
     }
     else if(edges[connect_edge].get_state() == Edge::BRANCH)
-        send(std::make_shared<INIT>(id, q.get_sender(), Component(edges[connect_edge].get_weight(), component.level + 1), Node::SEARCH));
+        send(std::make_shared<INIT>(id, q.get_sender(), Component(edges[connect_edge].get_weight(), component.level + 1), component.level + 1 < level_cap ? Node::SEARCH : Node::FOUND));
     else
         postpone(q.shared_from_this());
 }
 
 void Node::visit(const REJECT& q)
 {
+    PROFILE(PROFILE_REJECT);
+
     size_t connect_edge = get_edge(q.get_sender());
     if(edges[connect_edge].get_state() == Edge::UNKNOWN)
-        edges[connect_edge].state = Edge::REJECTED;
+        mark_edge(connect_edge, Edge::REJECTED);
 
     test();
 }
 
 void Node::visit(const REPORT& q)
 {
+    PROFILE(PROFILE_REPORT);
+
     size_t connect_edge = get_edge(q.get_sender());
     if(q.get_sender() != parent)
     {
@@ -239,20 +345,23 @@ void Node::visit(const REPORT& q)
         else if(q.best_edge_weight == Edge::INF_WEIGHT && best_edge_weight == Edge::INF_WEIGHT)
         {
             state = Node::END;
-            for(const Edge& i : edges)
-                if(i.get_state() == Edge::BRANCH && i.get_end() != parent)
-                    send(std::make_shared<::END>(id, i.get_end()));
+
+            std::vector<size_t> children = get_children();
+            if(!children.empty())
+                send(std::move(children), std::make_shared<::END>(id, Emulator_query::MULTICAST));
         }
     }
 }
 
 void Node::visit(const TEST& q)
 {
+    PROFILE(PROFILE_TEST);
+
     size_t connect_edge = get_edge(q.get_sender());
     if(q.component.fragment == component.fragment)
     {
         if(edges[connect_edge].get_state() == Edge::UNKNOWN)
-            edges[connect_edge].state = Edge::REJECTED;
+            mark_edge(connect_edge, Edge::REJECTED);
 
         if(q.get_sender() != test_node)
             send(std::make_shared<REJECT>(id, q.get_sender()));
@@ -267,13 +376,15 @@ void Node::visit(const TEST& q)
 
 void Node::visit(const WAKE_UP& q)
 {
+    PROFILE(PROFILE_WAKE_UP);
+
     if(state == Node::SLEEP)
     {
         best_edge = find_min_edge();
         if(best_edge != Edge::UDEF)
         {
             state = Node::FOUND;
-            edges[best_edge].state = Edge::BRANCH;
+            mark_edge(best_edge, Edge::BRANCH);
             send(std::make_shared<CONNECT>(id, edges[best_edge].get_end(), component));
         }
         else
@@ -283,6 +394,8 @@ void Node::visit(const WAKE_UP& q)
 
 void Node::visit(const ACCEPT& q)
 {
+    PROFILE(PROFILE_ACCEPT);
+
     size_t connect_edge = get_edge(q.get_sender());
     test_node = Node::UDEF;
 
@@ -297,10 +410,13 @@ void Node::visit(const ACCEPT& q)
 
 void Node::visit(const ::END& q)
 {
+    PROFILE(PROFILE_END);
+
     state = Node::END;
-    for(const Edge& i : edges)
-        if(i.get_end() != parent && i.get_state() == Edge::BRANCH)
-            send(std::make_shared<::END>(id, i.get_end()));
+
+    std::vector<size_t> children = get_children();
+    if(!children.empty())
+        send(std::move(children), std::make_shared<::END>(id, Emulator_query::MULTICAST));
 }
 
 void INIT::accept(Visitor& visitor) const
@@ -348,3 +464,113 @@ void END::accept(Visitor& visitor) const
     visitor.visit(*this);
 }
 
+
+unsigned char INIT::get_type() const
+{
+    return 0;
+}
+
+const char* INIT::get_name() const
+{
+    return "INIT";
+}
+
+size_t INIT::get_payload(size_t i) const
+{
+    return i == 0 ? component.fragment : component.level;
+}
+
+unsigned char CHANGE_CORE::get_type() const
+{
+    return 1;
+}
+
+const char* CHANGE_CORE::get_name() const
+{
+    return "CHANGE_CORE";
+}
+
+unsigned char CONNECT::get_type() const
+{
+    return 2;
+}
+
+const char* CONNECT::get_name() const
+{
+    return "CONNECT";
+}
+
+size_t CONNECT::get_payload(size_t i) const
+{
+    return i == 0 ? component.fragment : component.level;
+}
+
+unsigned char REJECT::get_type() const
+{
+    return 3;
+}
+
+const char* REJECT::get_name() const
+{
+    return "REJECT";
+}
+
+unsigned char REPORT::get_type() const
+{
+    return 4;
+}
+
+const char* REPORT::get_name() const
+{
+    return "REPORT";
+}
+
+size_t REPORT::get_payload(size_t i) const
+{
+    return i == 0 ? best_edge_weight : 0;
+}
+
+unsigned char TEST::get_type() const
+{
+    return 5;
+}
+
+const char* TEST::get_name() const
+{
+    return "TEST";
+}
+
+size_t TEST::get_payload(size_t i) const
+{
+    return i == 0 ? component.fragment : component.level;
+}
+
+unsigned char WAKE_UP::get_type() const
+{
+    return 6;
+}
+
+const char* WAKE_UP::get_name() const
+{
+    return "WAKE_UP";
+}
+
+unsigned char ACCEPT::get_type() const
+{
+    return 7;
+}
+
+const char* ACCEPT::get_name() const
+{
+    return "ACCEPT";
+}
+
+unsigned char END::get_type() const
+{
+    return 8;
+}
+
+const char* END::get_name() const
+{
+    return "END";
+}
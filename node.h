@@ -4,7 +4,7 @@
 #include <vector>
 #include <deque>
 #include <queue>
-#include <climits>
+#include <limits>
 #include <memory>
 
 #include "graph_as_vector.h"
@@ -36,7 +36,8 @@ class Edge
 
 public:
     enum State {UNKNOWN, REJECTED, BRANCH};
-    enum {INF_WEIGHT = INT_MAX, UDEF = INT_MAX};
+    static constexpr size_t INF_WEIGHT = std::numeric_limits<size_t>::max();
+    static constexpr size_t UDEF = std::numeric_limits<size_t>::max();
 
 private:
     size_t end, weight;
@@ -71,10 +72,11 @@ public:
     enum State {SLEEP, FOUND, SEARCH, END};
 
 private:
-    enum {UDEF = INT_MAX};
-    size_t id, parent, best_edge_weight, best_edge, test_node, reports;
+    static constexpr size_t UDEF = std::numeric_limits<size_t>::max();
+
+    size_t id, parent, best_edge_weight, best_edge, test_node, reports, level_cap, branch_num, rejected_num;
     State state;
-    bool checking_postponed;
+    bool checking_postponed, core_moved;
     Component component;
 
     std::vector<Edge> edges;
@@ -83,7 +85,10 @@ private:
 
     size_t get_edge(size_t end) const;
     size_t find_min_edge() const;
+    void mark_edge(size_t i, Edge::State state_);
     void send(std::shared_ptr<const Query> q);
+    void send(std::vector<size_t> recipients, std::shared_ptr<const Query> q);
+    std::vector<size_t> get_children() const;
     void postpone(std::shared_ptr<const Query> q);
     void test();
     void report();
@@ -109,6 +114,18 @@ public:
     virtual void add_edge(size_t end, size_t weight) override;
     virtual const std::deque<std::shared_ptr<const Emulator_query>>& wake_up() override;
     virtual bool ended() const override;
+    virtual unsigned char get_state() const override;
+    virtual size_t get_priority() const override;
+    virtual size_t get_fragment() const override;
+    virtual size_t get_signature() const override;
+    virtual size_t get_phase_num() const override;
+
+    void seed(const Component& component_, State state_);
+    void set_edge_state(size_t end, Edge::State state_);
+    void set_level_cap(size_t level_cap_);
+
+    const Component& get_component() const;
+    size_t get_level_cap() const;
 };
 
 struct Query : public Emulator_query, public std::enable_shared_from_this<Query>
@@ -127,6 +144,9 @@ struct INIT : public Query
     INIT() = default;
     INIT(size_t sender, size_t recipient, const Component& component, Node::State state) : Query(sender, recipient), state(state), component(component) {};
     virtual void accept(Visitor& visitor) const override;
+    virtual unsigned char get_type() const override;
+    virtual const char* get_name() const override;
+    virtual size_t get_payload(size_t i) const override;
 };
 
 struct CHANGE_CORE : public Query
@@ -134,6 +154,8 @@ struct CHANGE_CORE : public Query
     CHANGE_CORE() = default;
     CHANGE_CORE(size_t sender, size_t recipient) : Query(sender, recipient) {};
     virtual void accept(Visitor& visitor) const override;
+    virtual unsigned char get_type() const override;
+    virtual const char* get_name() const override;
 };
 
 struct CONNECT : public Query
@@ -143,6 +165,9 @@ struct CONNECT : public Query
     CONNECT() = default;
     CONNECT(size_t sender, size_t recipient, const Component& component) : Query(sender, recipient), component(component) {};
     virtual void accept(Visitor& visitor) const override;
+    virtual unsigned char get_type() const override;
+    virtual const char* get_name() const override;
+    virtual size_t get_payload(size_t i) const override;
 };
 
 struct REJECT : public Query
@@ -150,6 +175,8 @@ struct REJECT : public Query
     REJECT() = default;
     REJECT(size_t sender, size_t recipient) : Query(sender, recipient) {};
     virtual void accept(Visitor& visitor) const override;
+    virtual unsigned char get_type() const override;
+    virtual const char* get_name() const override;
 };
 
 struct REPORT : public Query
@@ -159,6 +186,9 @@ struct REPORT : public Query
     REPORT() = default;
     REPORT(size_t sender, size_t recipient, size_t best_edge_weight) : Query(sender, recipient), best_edge_weight(best_edge_weight) {};
     virtual void accept(Visitor& visitor) const override;
+    virtual unsigned char get_type() const override;
+    virtual const char* get_name() const override;
+    virtual size_t get_payload(size_t i) const override;
 };
 
 struct TEST : public Query
@@ -168,6 +198,9 @@ struct TEST : public Query
     TEST() = default;
     TEST(size_t sender, size_t recipient, const Component& component) : Query(sender, recipient), component(component) {};
     virtual void accept(Visitor& visitor) const override;
+    virtual unsigned char get_type() const override;
+    virtual const char* get_name() const override;
+    virtual size_t get_payload(size_t i) const override;
 };
 
 struct WAKE_UP : public Query
@@ -175,6 +208,8 @@ struct WAKE_UP : public Query
     WAKE_UP() = default;
     WAKE_UP(size_t sender, size_t recipient) : Query(sender, recipient) {};
     virtual void accept(Visitor& visitor) const override;
+    virtual unsigned char get_type() const override;
+    virtual const char* get_name() const override;
 };
 
 struct ACCEPT : public Query
@@ -182,6 +217,8 @@ struct ACCEPT : public Query
     ACCEPT() = default;
     ACCEPT(size_t sender, size_t recipient) : Query(sender, recipient) {};
     virtual void accept(Visitor& visitor) const override;
+    virtual unsigned char get_type() const override;
+    virtual const char* get_name() const override;
 };
 
 struct END : public Query
@@ -189,6 +226,8 @@ struct END : public Query
     END() = default;
     END(size_t sender, size_t recipient) : Query(sender, recipient) {};
     virtual void accept(Visitor& visitor) const override;
+    virtual unsigned char get_type() const override;
+    virtual const char* get_name() const override;
 };
 
 #endif // NODE_H_INCLUDED
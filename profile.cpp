@@ -0,0 +1,135 @@
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "profile.h"
+
+namespace
+{
+
+const char* const POINT_NAMES[PROFILE_POINT_NUM] = {"INIT", "CHANGE_CORE", "CONNECT", "REJECT", "REPORT", "TEST", "WAKE_UP", "ACCEPT", "END", "check_postponed", "find_min_edge", "get_edge"};
+
+}
+
+Histogram::Histogram() : count(0), sum(0), max(0)
+{
+    buckets.fill(0);
+}
+
+size_t Histogram::bucket(uint64_t value)
+{
+    if(value < SUB_NUM)
+        return value;
+
+    size_t exponent = 63 - __builtin_clzll(value);
+    return (exponent - SUB_BITS + 1) * SUB_NUM + ((value >> (exponent - SUB_BITS)) & (SUB_NUM - 1));
+}
+
+uint64_t Histogram::bucket_value(size_t i)
+{
+    if(i < SUB_NUM)
+        return i;
+
+    size_t exponent = i / SUB_NUM + SUB_BITS - 1;
+    return (SUB_NUM + i % SUB_NUM) << (exponent - SUB_BITS);
+}
+
+void Histogram::add(uint64_t value)
+{
+    ++buckets[bucket(value)];
+    ++count;
+    sum += value;
+    max = std::max(max, value);
+}
+
+void Histogram::merge(const Histogram& h)
+{
+    for(size_t i = 0; i < BUCKET_NUM; ++i)
+        buckets[i] += h.buckets[i];
+    count += h.count;
+    sum += h.sum;
+    max = std::max(max, h.max);
+}
+
+uint64_t Histogram::get_count() const
+{
+    return count;
+}
+
+uint64_t Histogram::get_sum() const
+{
+    return sum;
+}
+
+uint64_t Histogram::get_max() const
+{
+    return max;
+}
+
+uint64_t Histogram::percentile(double p) const
+{
+    uint64_t rank = static_cast<uint64_t>(p * count), seen = 0;
+    for(size_t i = 0; i < BUCKET_NUM; ++i)
+    {
+        seen += buckets[i];
+        if(seen > rank)
+            return bucket_value(i);
+    }
+    return max;
+}
+
+void Handler_profile::merge(const Handler_profile& p)
+{
+    for(size_t i = 0; i < PROFILE_POINT_NUM; ++i)
+        points[i].merge(p.points[i]);
+}
+
+uint64_t profile_clock()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+Handler_profile& handler_profile()
+{
+    thread_local Handler_profile profile;
+    return profile;
+}
+
+Handler_profile take_handler_profile()
+{
+    Handler_profile result = handler_profile();
+    handler_profile() = Handler_profile();
+    return result;
+}
+
+std::ostream& operator<<(std::ostream& stream, const Handler_profile& profile)
+{
+    stream << std::setw(16) << std::left << "point" << std::right
+           << std::setw(12) << "count" << std::setw(16) << "total"
+           << std::setw(10) << "mean" << std::setw(10) << "p50"
+           << std::setw(10) << "p99" << std::setw(12) << "max" << std::endl;
+
+    for(size_t i = 0; i < PROFILE_POINT_NUM; ++i)
+    {
+        const Histogram& h = profile.points[i];
+        if(h.get_count() == 0)
+            continue;
+
+        stream << std::setw(16) << std::left << POINT_NAMES[i] << std::right
+               << std::setw(12) << h.get_count() << std::setw(16) << h.get_sum()
+               << std::setw(10) << h.get_sum() / h.get_count() << std::setw(10) << h.percentile(0.5)
+               << std::setw(10) << h.percentile(0.99) << std::setw(12) << h.get_max() << std::endl;
+    }
+
+    return stream;
+}
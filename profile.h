@@ -0,0 +1,87 @@
+#ifndef PROFILE_H_INCLUDED
+#define PROFILE_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <iostream>
+
+//#define PROFILE_HANDLERS
+
+enum Profile_point
+{
+    PROFILE_INIT,
+    PROFILE_CHANGE_CORE,
+    PROFILE_CONNECT,
+    PROFILE_REJECT,
+    PROFILE_REPORT,
+    PROFILE_TEST,
+    PROFILE_WAKE_UP,
+    PROFILE_ACCEPT,
+    PROFILE_END,
+    PROFILE_CHECK_POSTPONED,
+    PROFILE_FIND_MIN_EDGE,
+    PROFILE_GET_EDGE,
+    PROFILE_POINT_NUM
+};
+
+class Histogram
+{
+public:
+    static constexpr size_t SUB_BITS = 3;
+    static constexpr size_t SUB_NUM = size_t(1) << SUB_BITS;
+    static constexpr size_t BUCKET_NUM = (64 - SUB_BITS + 1) * SUB_NUM;
+
+private:
+    std::array<uint64_t, BUCKET_NUM> buckets;
+    uint64_t count, sum, max;
+
+    static size_t bucket(uint64_t value);
+    static uint64_t bucket_value(size_t i);
+
+public:
+    Histogram();
+
+    void add(uint64_t value);
+    void merge(const Histogram& h);
+
+    uint64_t get_count() const;
+    uint64_t get_sum() const;
+    uint64_t get_max() const;
+    uint64_t percentile(double p) const;
+};
+
+struct Handler_profile
+{
+    std::array<Histogram, PROFILE_POINT_NUM> points;
+
+    void merge(const Handler_profile& p);
+};
+
+uint64_t profile_clock();
+Handler_profile& handler_profile();
+Handler_profile take_handler_profile();
+
+std::ostream& operator<<(std::ostream& stream, const Handler_profile& profile);
+
+class Profile_scope
+{
+private:
+    Profile_point point;
+    uint64_t start;
+
+public:
+    Profile_scope(Profile_point point) : point(point), start(profile_clock()) {};
+    ~Profile_scope()
+    {
+        handler_profile().points[point].add(profile_clock() - start);
+    }
+};
+
+#ifdef PROFILE_HANDLERS
+#define PROFILE(point) Profile_scope profile_scope(point)
+#else
+#define PROFILE(point)
+#endif // PROFILE_HANDLERS
+
+#endif // PROFILE_H_INCLUDED
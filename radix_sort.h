@@ -0,0 +1,120 @@
+#ifndef RADIX_SORT_H_INCLUDED
+#define RADIX_SORT_H_INCLUDED
+
+#include <cstddef>
+#include <vector>
+#include <array>
+#include <thread>
+#include <algorithm>
+#include <type_traits>
+#include <climits>
+
+template<typename T>
+unsigned char key_byte(T value, size_t i)
+{
+    typedef typename std::make_unsigned<T>::type Unsigned;
+
+    Unsigned key = static_cast<Unsigned>(value);
+    if(std::is_signed<T>::value)
+        key ^= Unsigned(1) << (sizeof(T) * CHAR_BIT - 1);
+
+    return static_cast<unsigned char>(key >> (i * CHAR_BIT));
+}
+
+template<typename T>
+unsigned char bit_width(T value)
+{
+    unsigned char result = 0;
+    for(; value != 0; value >>= 1)
+        ++result;
+    return result;
+}
+
+template<size_t DIGIT_BITS, typename T, typename Digit>
+void radix_sort(std::vector<T>& data, size_t digit_num, Digit digit, size_t thread_num = 1)
+{
+    constexpr size_t BUCKET_NUM = size_t(1) << DIGIT_BITS;
+    const size_t MIN_CHUNK = 1 << 16;
+
+    size_t n = data.size();
+    thread_num = std::max<size_t>(1, std::min(thread_num, n / MIN_CHUNK));
+
+    std::vector<T> buffer(n);
+    std::vector<T>* from = &data;
+    std::vector<T>* to = &buffer;
+
+    std::vector<size_t> bounds(thread_num + 1);
+    for(size_t t = 0; t <= thread_num; ++t)
+        bounds[t] = n * t / thread_num;
+
+    auto run = [thread_num](auto task)
+    {
+        if(thread_num == 1)
+        {
+            task(0);
+            return;
+        }
+
+        std::vector<std::thread> workers;
+        for(size_t t = 0; t < thread_num; ++t)
+            workers.emplace_back(task, t);
+        for(std::thread& i : workers)
+            i.join();
+    };
+
+    std::vector<std::vector<std::array<size_t, BUCKET_NUM>>> counts(thread_num, std::vector<std::array<size_t, BUCKET_NUM>>(digit_num));
+    run([&](size_t t)
+    {
+        for(std::array<size_t, BUCKET_NUM>& i : counts[t])
+            i.fill(0);
+        for(size_t i = bounds[t]; i < bounds[t + 1]; ++i)
+            for(size_t d = 0; d < digit_num; ++d)
+                ++counts[t][d][digit(data[i], d)];
+    });
+
+    bool permuted = false;
+    for(size_t d = 0; d < digit_num; ++d)
+    {
+        bool trivial = false;
+        for(size_t b = 0; b < BUCKET_NUM && !trivial; ++b)
+        {
+            size_t total = 0;
+            for(size_t t = 0; t < thread_num; ++t)
+                total += counts[t][d][b];
+            trivial = total == n;
+        }
+        if(trivial)
+            continue;
+
+        if(permuted && thread_num > 1)
+            run([&](size_t t)
+            {
+                counts[t][d].fill(0);
+                for(size_t i = bounds[t]; i < bounds[t + 1]; ++i)
+                    ++counts[t][d][digit((*from)[i], d)];
+            });
+
+        size_t offset = 0;
+        for(size_t b = 0; b < BUCKET_NUM; ++b)
+            for(size_t t = 0; t < thread_num; ++t)
+            {
+                size_t count = counts[t][d][b];
+                counts[t][d][b] = offset;
+                offset += count;
+            }
+
+        run([&](size_t t)
+        {
+            for(size_t i = bounds[t]; i < bounds[t + 1]; ++i)
+                (*to)[counts[t][d][digit((*from)[i], d)]++] = (*from)[i];
+        });
+
+        std::swap(from, to);
+        permuted = true;
+    }
+
+    if(from != &data)
+        data.swap(buffer);
+}
+
+#endif // RADIX_SORT_H_INCLUDED
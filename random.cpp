@@ -1,10 +1,28 @@
 #include <random>
 
+#include "random.h"
+
 size_t rnd(size_t from, size_t to)
 {
-    static std::random_device generator;
+    static thread_local std::random_device generator;
 
     std::uniform_int_distribution<size_t> distribution(from, to);
 
     return distribution(generator);
 }
+
+Random::Random(size_t seed) : generator(seed)
+{
+}
+
+size_t Random::operator()(size_t from, size_t to)
+{
+    std::uniform_int_distribution<size_t> distribution(from, to);
+
+    return distribution(generator);
+}
+
+std::mt19937_64& Random::get_generator()
+{
+    return generator;
+}
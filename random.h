@@ -1,6 +1,20 @@
 #ifndef RANDOM_H_INCLUDED
 #define RANDOM_H_INCLUDED
 
+#include <random>
+
 size_t rnd(size_t from, size_t to);
 
+class Random
+{
+private:
+    std::mt19937_64 generator;
+
+public:
+    Random(size_t seed);
+
+    size_t operator()(size_t from, size_t to);
+    std::mt19937_64& get_generator();
+};
+
 #endif // RANDOM_H_INCLUDED
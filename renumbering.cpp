@@ -0,0 +1,6 @@
+#include <cstddef>
+
+#include "renumbering.h"
+#include "graph_as_vector.h"
+
+template class Basic_renumbering<size_t, size_t>;
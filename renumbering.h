@@ -0,0 +1,182 @@
+#ifndef RENUMBERING_H_INCLUDED
+#define RENUMBERING_H_INCLUDED
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#include "graph_as_vector.h"
+
+enum Renumbering_strategy {BFS_ORDER, RCM_ORDER, DEGREE_ORDER};
+
+template<typename Index, typename Weight>
+class Basic_renumbering
+{
+public:
+    typedef Basic_graph_as_vector<Index, Weight> Graph;
+
+private:
+    static constexpr Index UDEF = std::numeric_limits<Index>::max();
+
+    std::vector<Index> order, position;
+
+    std::vector<size_t> offsets;
+    std::vector<Index> ends;
+
+    void build_adjacency(const Graph& graph);
+    void breadth_first(const std::vector<Index>& starts, bool by_degree);
+
+public:
+    Basic_renumbering(const Graph& graph, Renumbering_strategy strategy);
+
+    Graph renumber(const Graph& graph) const;
+    Graph restore(const Graph& graph) const;
+
+    Index get_new_id(Index v) const;
+    Index get_original_id(Index v) const;
+};
+
+typedef Basic_renumbering<size_t, size_t> Renumbering;
+
+template<typename Index, typename Weight, typename Engine>
+Basic_graph_as_vector<Index, Weight> renumbered(const Basic_graph_as_vector<Index, Weight>& graph, Renumbering_strategy strategy, Engine engine);
+
+template<typename Index, typename Weight>
+Basic_renumbering<Index, Weight>::Basic_renumbering(const Graph& graph, Renumbering_strategy strategy) : position(graph.get_node_num(), UDEF)
+{
+    order.reserve(graph.get_node_num());
+    build_adjacency(graph);
+
+    std::vector<Index> nodes(graph.get_node_num());
+    for(Index i = 0; i < graph.get_node_num(); ++i)
+        nodes[i] = i;
+
+    switch(strategy)
+    {
+    case BFS_ORDER:
+        breadth_first(nodes, false);
+        break;
+    case RCM_ORDER:
+        std::stable_sort(nodes.begin(), nodes.end(), [this](Index a, Index b)
+        {
+            return offsets[a + 1] - offsets[a] < offsets[b + 1] - offsets[b];
+        });
+        breadth_first(nodes, true);
+        std::reverse(order.begin(), order.end());
+        break;
+    case DEGREE_ORDER:
+        std::stable_sort(nodes.begin(), nodes.end(), [this](Index a, Index b)
+        {
+            return offsets[a + 1] - offsets[a] > offsets[b + 1] - offsets[b];
+        });
+        order = nodes;
+        break;
+    }
+
+    for(Index i = 0; i < order.size(); ++i)
+        position[order[i]] = i;
+
+    offsets = std::vector<size_t>();
+    ends = std::vector<Index>();
+}
+
+template<typename Index, typename Weight>
+void Basic_renumbering<Index, Weight>::build_adjacency(const Graph& graph)
+{
+    offsets.assign(graph.get_node_num() + 1, 0);
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+    {
+        ++offsets[graph[i].get_first_node() + 1];
+        ++offsets[graph[i].get_second_node() + 1];
+    }
+    for(Index i = 0; i < graph.get_node_num(); ++i)
+        offsets[i + 1] += offsets[i];
+
+    std::vector<size_t> filled(offsets.begin(), offsets.end() - 1);
+    ends.resize(offsets.back());
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+    {
+        ends[filled[graph[i].get_first_node()]++] = graph[i].get_second_node();
+        ends[filled[graph[i].get_second_node()]++] = graph[i].get_first_node();
+    }
+}
+
+template<typename Index, typename Weight>
+void Basic_renumbering<Index, Weight>::breadth_first(const std::vector<Index>& starts, bool by_degree)
+{
+    for(Index s : starts)
+    {
+        if(position[s] != UDEF)
+            continue;
+
+        size_t head = order.size();
+        order.push_back(s);
+        position[s] = 0;
+
+        for(; head < order.size(); ++head)
+        {
+            Index v = order[head];
+            size_t first = order.size();
+
+            for(size_t i = offsets[v]; i < offsets[v + 1]; ++i)
+                if(position[ends[i]] == UDEF)
+                {
+                    position[ends[i]] = 0;
+                    order.push_back(ends[i]);
+                }
+
+            if(by_degree)
+                std::sort(order.begin() + first, order.end(), [this](Index a, Index b)
+                {
+                    return offsets[a + 1] - offsets[a] < offsets[b + 1] - offsets[b];
+                });
+        }
+    }
+}
+
+template<typename Index, typename Weight>
+typename Basic_renumbering<Index, Weight>::Graph Basic_renumbering<Index, Weight>::renumber(const Graph& graph) const
+{
+    Graph result(graph.get_node_num(), graph.get_edge_num());
+
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+        result.add_edge(typename Graph::Edge(position[graph[i].get_first_node()], position[graph[i].get_second_node()], graph[i].get_weight()));
+
+    return result;
+}
+
+template<typename Index, typename Weight>
+typename Basic_renumbering<Index, Weight>::Graph Basic_renumbering<Index, Weight>::restore(const Graph& graph) const
+{
+    Graph result(graph.get_node_num(), graph.get_edge_num());
+
+    for(size_t i = 0; i < graph.get_edge_num(); ++i)
+        result.add_edge(typename Graph::Edge(order[graph[i].get_first_node()], order[graph[i].get_second_node()], graph[i].get_weight()));
+
+    result.standartize();
+    return result;
+}
+
+template<typename Index, typename Weight>
+Index Basic_renumbering<Index, Weight>::get_new_id(Index v) const
+{
+    return position[v];
+}
+
+template<typename Index, typename Weight>
+Index Basic_renumbering<Index, Weight>::get_original_id(Index v) const
+{
+    return order[v];
+}
+
+template<typename Index, typename Weight, typename Engine>
+Basic_graph_as_vector<Index, Weight> renumbered(const Basic_graph_as_vector<Index, Weight>& graph, Renumbering_strategy strategy, Engine engine)
+{
+    Basic_renumbering<Index, Weight> renumbering(graph, strategy);
+
+    return renumbering.restore(engine(renumbering.renumber(graph)));
+}
+
+extern template class Basic_renumbering<size_t, size_t>;
+
+#endif // RENUMBERING_H_INCLUDED
@@ -0,0 +1,91 @@
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "scheduler.h"
+#include "random.h"
+
+void Fifo_scheduler::ready(size_t node, size_t priority)
+{
+    queue.push_back(node);
+}
+
+void Fifo_scheduler::select(std::vector<size_t>& round, Random& random)
+{
+    round.swap(queue);
+    queue.clear();
+}
+
+bool Fifo_scheduler::empty() const
+{
+    return queue.empty();
+}
+
+void Random_scheduler::ready(size_t node, size_t priority)
+{
+    nodes.push_back(node);
+}
+
+void Random_scheduler::select(std::vector<size_t>& round, Random& random)
+{
+    round.clear();
+    if(nodes.empty())
+        return;
+
+    size_t num = random(1, nodes.size());
+    for(size_t i = 0; i < num; ++i)
+    {
+        std::swap(nodes[random(0, nodes.size() - 1 - i)], nodes[nodes.size() - 1 - i]);
+        round.push_back(nodes[nodes.size() - 1 - i]);
+    }
+    nodes.resize(nodes.size() - num);
+}
+
+bool Random_scheduler::empty() const
+{
+    return nodes.empty();
+}
+
+void Level_scheduler::ready(size_t node, size_t priority)
+{
+    heap.push(std::make_pair(priority, node));
+}
+
+void Level_scheduler::select(std::vector<size_t>& round, Random& random)
+{
+    round.clear();
+    if(heap.empty())
+        return;
+
+    size_t level = heap.top().first;
+    while(!heap.empty() && heap.top().first == level)
+    {
+        round.push_back(heap.top().second);
+        heap.pop();
+    }
+}
+
+bool Level_scheduler::empty() const
+{
+    return heap.empty();
+}
+
+void Adversarial_scheduler::ready(size_t node, size_t priority)
+{
+    stack.push_back(node);
+}
+
+void Adversarial_scheduler::select(std::vector<size_t>& round, Random& random)
+{
+    round.clear();
+    if(stack.empty())
+        return;
+
+    round.push_back(stack.back());
+    stack.pop_back();
+}
+
+bool Adversarial_scheduler::empty() const
+{
+    return stack.empty();
+}
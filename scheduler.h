@@ -0,0 +1,65 @@
+#ifndef SCHEDULER_H_INCLUDED
+#define SCHEDULER_H_INCLUDED
+
+#include <cstddef>
+#include <vector>
+#include <queue>
+#include <utility>
+#include <functional>
+
+#include "random.h"
+
+class Scheduler
+{
+public:
+    virtual void ready(size_t node, size_t priority) = 0;
+    virtual void select(std::vector<size_t>& round, Random& random) = 0;
+    virtual bool empty() const = 0;
+    virtual ~Scheduler() = default;
+};
+
+class Fifo_scheduler : public Scheduler
+{
+private:
+    std::vector<size_t> queue;
+
+public:
+    virtual void ready(size_t node, size_t priority) override;
+    virtual void select(std::vector<size_t>& round, Random& random) override;
+    virtual bool empty() const override;
+};
+
+class Random_scheduler : public Scheduler
+{
+private:
+    std::vector<size_t> nodes;
+
+public:
+    virtual void ready(size_t node, size_t priority) override;
+    virtual void select(std::vector<size_t>& round, Random& random) override;
+    virtual bool empty() const override;
+};
+
+class Level_scheduler : public Scheduler
+{
+private:
+    std::priority_queue<std::pair<size_t, size_t>, std::vector<std::pair<size_t, size_t>>, std::greater<std::pair<size_t, size_t>>> heap;
+
+public:
+    virtual void ready(size_t node, size_t priority) override;
+    virtual void select(std::vector<size_t>& round, Random& random) override;
+    virtual bool empty() const override;
+};
+
+class Adversarial_scheduler : public Scheduler
+{
+private:
+    std::vector<size_t> stack;
+
+public:
+    virtual void ready(size_t node, size_t priority) override;
+    virtual void select(std::vector<size_t>& round, Random& random) override;
+    virtual bool empty() const override;
+};
+
+#endif // SCHEDULER_H_INCLUDED
@@ -0,0 +1,241 @@
+#ifndef STATIC_EMULATOR_H_INCLUDED
+#define STATIC_EMULATOR_H_INCLUDED
+
+#include <vector>
+#include <variant>
+#include <memory>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+
+#include "graph_as_vector.h"
+#include "mailbox.h"
+#include "random.h"
+#include "scheduler.h"
+#include "emulator.h"
+
+template<typename Message>
+struct Static_envelope
+{
+    size_t sender, recipient;
+    Message message;
+};
+
+template<typename NodeT, typename... Messages>
+class Static_emulator
+{
+public:
+    typedef std::variant<Messages...> Message;
+    typedef Static_envelope<Message> Envelope;
+
+    static_assert(std::is_same<Message, typename NodeT::Message>::value, "node and emulator message lists differ");
+
+private:
+    Mailbox<Envelope> box;
+    Mailbox<size_t> stamps;
+    std::vector<NodeT> nodes;
+    Link_clocks links;
+    std::vector<size_t> clocks;
+    Random random;
+    size_t round_num, message_num, ended_num, time;
+    std::shared_ptr<Scheduler> scheduler;
+    std::vector<bool> scheduled, awake, ended;
+    std::vector<size_t> sleeping;
+    std::vector<Envelope> out;
+
+    void schedule(size_t i);
+    void update_ended(size_t i);
+    void wake_up(size_t i);
+    void deliver(size_t i);
+    void random_wake_up();
+    void process_queries();
+
+public:
+    Static_emulator(const Graph_as_vector& graph, size_t seed);
+
+    const NodeT& operator[](size_t i) const;
+
+    void post(const Envelope& q);
+    void process();
+    void set_scheduler(std::shared_ptr<Scheduler> scheduler_);
+
+    size_t get_round_num() const;
+    size_t get_message_num() const;
+    size_t get_time() const;
+};
+
+template<typename NodeT, typename... Messages>
+Static_emulator<NodeT, Messages...>::Static_emulator(const Graph_as_vector& graph_, size_t seed) : box(graph_.get_node_num()), stamps(graph_.get_node_num()), nodes(graph_.get_node_num()), links(graph_), clocks(graph_.get_node_num(), 0), random(seed),
+    round_num(0), message_num(0), ended_num(0), time(0), scheduler(std::make_shared<Random_scheduler>()), scheduled(graph_.get_node_num(), false), awake(graph_.get_node_num(), false), ended(graph_.get_node_num(), false)
+{
+    for(size_t i = 0; i < nodes.size(); ++i)
+        nodes[i].set_id(i);
+
+    for(size_t i = 0; i < graph_.get_edge_num(); ++i)
+    {
+        nodes[graph_[i].get_first_node()].add_edge(graph_[i].get_second_node(), graph_[i].get_weight());
+        nodes[graph_[i].get_second_node()].add_edge(graph_[i].get_first_node(), graph_[i].get_weight());
+    }
+}
+
+template<typename NodeT, typename... Messages>
+const NodeT& Static_emulator<NodeT, Messages...>::operator[](size_t i) const
+{
+    return nodes[i];
+}
+
+template<typename NodeT, typename... Messages>
+size_t Static_emulator<NodeT, Messages...>::get_round_num() const
+{
+    return round_num;
+}
+
+template<typename NodeT, typename... Messages>
+size_t Static_emulator<NodeT, Messages...>::get_message_num() const
+{
+    return message_num;
+}
+
+template<typename NodeT, typename... Messages>
+size_t Static_emulator<NodeT, Messages...>::get_time() const
+{
+    return time;
+}
+
+template<typename NodeT, typename... Messages>
+void Static_emulator<NodeT, Messages...>::process_queries()
+{
+    for(Envelope& i : out)
+    {
+        size_t& last = links(i.sender, i.recipient);
+        last = std::max(last, clocks[i.sender]) + 1;
+
+        size_t recipient = i.recipient;
+        box.push_back(recipient, std::move(i));
+        stamps.push_back(recipient, last);
+        schedule(recipient);
+        ++message_num;
+    }
+
+    out.clear();
+}
+
+template<typename NodeT, typename... Messages>
+void Static_emulator<NodeT, Messages...>::post(const Envelope& q)
+{
+    out.push_back(q);
+    process_queries();
+}
+
+template<typename NodeT, typename... Messages>
+void Static_emulator<NodeT, Messages...>::set_scheduler(std::shared_ptr<Scheduler> scheduler_)
+{
+    scheduler = scheduler_;
+
+    for(size_t i = 0; i < nodes.size(); ++i)
+    {
+        scheduled[i] = false;
+        if(!box.empty(i))
+            schedule(i);
+    }
+}
+
+template<typename NodeT, typename... Messages>
+void Static_emulator<NodeT, Messages...>::schedule(size_t i)
+{
+    if(!scheduled[i])
+    {
+        scheduled[i] = true;
+        scheduler->ready(i, nodes[i].get_priority());
+    }
+}
+
+template<typename NodeT, typename... Messages>
+void Static_emulator<NodeT, Messages...>::update_ended(size_t i)
+{
+    if(!ended[i] && nodes[i].ended())
+    {
+        ended[i] = true;
+        ++ended_num;
+    }
+}
+
+template<typename NodeT, typename... Messages>
+void Static_emulator<NodeT, Messages...>::wake_up(size_t i)
+{
+    awake[i] = true;
+
+    nodes[i].wake_up(out);
+    process_queries();
+    update_ended(i);
+}
+
+template<typename NodeT, typename... Messages>
+void Static_emulator<NodeT, Messages...>::deliver(size_t i)
+{
+    Envelope q = std::move(box.front(i));
+    box.pop_front(i);
+    awake[i] = true;
+
+    clocks[i] = std::max(clocks[i], stamps.front(i));
+    time = std::max(time, clocks[i]);
+    stamps.pop_front(i);
+
+    nodes[i].tick(q, out);
+    process_queries();
+
+    update_ended(i);
+    if(!box.empty(i))
+        schedule(i);
+}
+
+template<typename NodeT, typename... Messages>
+void Static_emulator<NodeT, Messages...>::random_wake_up()
+{
+    if(sleeping.empty())
+        throw bad_ghs();
+
+    for(size_t num = random(1, sleeping.size()); num > 0 && !sleeping.empty(); )
+    {
+        size_t j = random(0, sleeping.size() - 1), i = sleeping[j];
+        sleeping[j] = sleeping.back();
+        sleeping.pop_back();
+
+        if(!awake[i])
+        {
+            wake_up(i);
+            --num;
+        }
+    }
+}
+
+template<typename NodeT, typename... Messages>
+void Static_emulator<NodeT, Messages...>::process()
+{
+    sleeping.clear();
+    for(size_t i = 0; i < nodes.size(); ++i)
+    {
+        update_ended(i);
+        if(!ended[i] && !awake[i])
+            sleeping.push_back(i);
+    }
+
+    std::vector<size_t> round;
+    while(ended_num < nodes.size())
+    {
+        if(scheduler->empty())
+            random_wake_up();
+
+        ++round_num;
+
+        scheduler->select(round, random);
+        for(size_t i : round)
+            scheduled[i] = false;
+
+        for(size_t i : round)
+            if(!box.empty(i))
+                deliver(i);
+    }
+}
+
+#endif // STATIC_EMULATOR_H_INCLUDED
@@ -0,0 +1,324 @@
+#include <vector>
+#include <queue>
+#include <variant>
+#include <algorithm>
+#include <limits>
+
+#include "static_node.h"
+#include "static_emulator.h"
+#include "node.h"
+#include "random.h"
+
+Static_node::Static_node() : id(0), parent(0), best_edge_weight(Edge::INF_WEIGHT), best_edge(Edge::UDEF), test_node(UDEF), reports(0), state(Node::SLEEP), checking_postponed(false), component(Edge::UDEF, 0), result(nullptr)
+{
+}
+
+void Static_node::set_id(size_t id_)
+{
+    id = id_;
+    parent = id_;
+}
+
+void Static_node::add_edge(size_t end, size_t weight)
+{
+    edges.push_back(Link{end, weight, Edge::UNKNOWN});
+}
+
+Graph_as_vector Static_node::get_branches() const
+{
+    Graph_as_vector result_;
+
+    for(const Link& i : edges)
+        if(i.state == Edge::BRANCH)
+            result_.add_edge(Graph_as_vector::Edge(id, i.end, i.weight));
+
+    return result_;
+}
+
+bool Static_node::ended() const
+{
+    return state == Node::END;
+}
+
+size_t Static_node::get_priority() const
+{
+    return component.level;
+}
+
+size_t Static_node::get_phase_num() const
+{
+    return component.level + 1;
+}
+
+void Static_node::tick(const Envelope& q, std::vector<Envelope>& out)
+{
+    result = &out;
+
+    if(state == Node::SLEEP)
+        wake_up();
+
+    dispatch(q);
+}
+
+void Static_node::wake_up(std::vector<Envelope>& out)
+{
+    result = &out;
+
+    wake_up();
+}
+
+size_t Static_node::get_edge(size_t end) const
+{
+    return std::distance(edges.begin(), std::find_if(edges.begin(), edges.end(), [end](const Link& e)
+    {
+        return e.end == end;
+    }));
+}
+
+size_t Static_node::find_min_edge() const
+{
+    std::pair<size_t, size_t> min(Edge::UDEF, Edge::INF_WEIGHT);
+    for(size_t i = 0; i < edges.size(); ++i)
+        if(edges[i].state == Edge::UNKNOWN && edges[i].weight < min.second)
+        {
+            min.first = i;
+            min.second = edges[i].weight;
+        }
+    return min.first;
+}
+
+void Static_node::send(size_t recipient, Message q)
+{
+    result->push_back(Envelope{id, recipient, std::move(q)});
+}
+
+void Static_node::dispatch(const Envelope& q)
+{
+    std::visit([this, &q](const auto& m)
+    {
+        on(q, m);
+    }, q.message);
+}
+
+void Static_node::check_postponed()
+{
+    if(checking_postponed)
+        return;
+
+    checking_postponed = true;
+    for(size_t i = 0, j = postponed.size(); i < j; ++i)
+    {
+        Envelope q = std::move(postponed.front());
+        postponed.pop();
+        dispatch(q);
+    }
+    checking_postponed = false;
+}
+
+void Static_node::test()
+{
+    size_t min_edge = find_min_edge();
+    if(min_edge != Edge::UDEF)
+    {
+        test_node = edges[min_edge].end;
+        send(edges[min_edge].end, Static_test{component});
+    }
+    else
+    {
+        test_node = UDEF;
+        report();
+    }
+}
+
+void Static_node::report()
+{
+    size_t sons_num = 0;
+    for(size_t i = 0; i < edges.size(); ++i)
+        sons_num += edges[i].state == Edge::BRANCH && edges[i].end != parent;
+
+    if(sons_num == reports && test_node == UDEF)
+    {
+        state = Node::FOUND;
+        send(parent, Static_report{best_edge_weight});
+
+        check_postponed();
+    }
+}
+
+void Static_node::change_core()
+{
+    if(edges[best_edge].state == Edge::BRANCH)
+        send(edges[best_edge].end, Static_change_core());
+    else
+    {
+        send(edges[best_edge].end, Static_connect{component});
+        edges[best_edge].state = Edge::BRANCH;
+
+        check_postponed();
+    }
+}
+
+void Static_node::wake_up()
+{
+    if(state == Node::SLEEP)
+    {
+        best_edge = find_min_edge();
+        if(best_edge != Edge::UDEF)
+        {
+            state = Node::FOUND;
+            edges[best_edge].state = Edge::BRANCH;
+            send(edges[best_edge].end, Static_connect{component});
+        }
+        else
+            state = Node::END;
+    }
+}
+
+void Static_node::on(const Envelope& q, const Static_init& m)
+{
+    component = m.component;
+    state = m.state;
+    parent = q.sender;
+    best_edge = Edge::UDEF;
+    best_edge_weight = Edge::INF_WEIGHT;
+
+    for(const Link& i : edges)
+        if(i.state == Edge::BRANCH && i.end != parent)
+            send(i.end, m);
+
+    if(state == Node::SEARCH)
+    {
+        reports = 0;
+        test();
+    }
+
+    check_postponed();
+}
+
+void Static_node::on(const Envelope& q, const Static_change_core& m)
+{
+    change_core();
+}
+
+void Static_node::on(const Envelope& q, const Static_connect& m)
+{
+    size_t connect_edge = get_edge(q.sender);
+    if(m.component.level < component.level)
+    {
+        edges[connect_edge].state = Edge::BRANCH;
+
+        send(q.sender, Static_init{state, component});
+    }
+    else if(edges[connect_edge].state == Edge::BRANCH)
+        send(q.sender, Static_init{Node::SEARCH, Component(edges[connect_edge].weight, component.level + 1)});
+    else
+        postponed.push(q);
+}
+
+void Static_node::on(const Envelope& q, const Static_reject& m)
+{
+    size_t connect_edge = get_edge(q.sender);
+    if(edges[connect_edge].state == Edge::UNKNOWN)
+        edges[connect_edge].state = Edge::REJECTED;
+
+    test();
+}
+
+void Static_node::on(const Envelope& q, const Static_report& m)
+{
+    size_t connect_edge = get_edge(q.sender);
+    if(q.sender != parent)
+    {
+        if(m.best_edge_weight < best_edge_weight)
+        {
+            best_edge_weight = m.best_edge_weight;
+            best_edge = connect_edge;
+        }
+
+        reports++;
+        report();
+    }
+    else
+    {
+        if(state == Node::SEARCH)
+            postponed.push(q);
+        else if(m.best_edge_weight > best_edge_weight)
+            change_core();
+        else if(m.best_edge_weight == Edge::INF_WEIGHT && best_edge_weight == Edge::INF_WEIGHT)
+        {
+            state = Node::END;
+            for(const Link& i : edges)
+                if(i.state == Edge::BRANCH && i.end != parent)
+                    send(i.end, Static_end());
+        }
+    }
+}
+
+void Static_node::on(const Envelope& q, const Static_test& m)
+{
+    size_t connect_edge = get_edge(q.sender);
+    if(m.component.fragment == component.fragment)
+    {
+        if(edges[connect_edge].state == Edge::UNKNOWN)
+            edges[connect_edge].state = Edge::REJECTED;
+
+        if(q.sender != test_node)
+            send(q.sender, Static_reject());
+        else
+            test();
+    }
+    else if(m.component.level <= component.level)
+        send(q.sender, Static_accept());
+    else
+        postponed.push(q);
+}
+
+void Static_node::on(const Envelope& q, const Static_accept& m)
+{
+    size_t connect_edge = get_edge(q.sender);
+    test_node = UDEF;
+
+    if(edges[connect_edge].weight < best_edge_weight)
+    {
+        best_edge_weight = edges[connect_edge].weight;
+        best_edge = connect_edge;
+    }
+
+    report();
+}
+
+void Static_node::on(const Envelope& q, const Static_end& m)
+{
+    state = Node::END;
+    for(const Link& i : edges)
+        if(i.end != parent && i.state == Edge::BRANCH)
+            send(i.end, Static_end());
+}
+
+Graph_as_vector static_ghs(const Graph_as_vector& graph)
+{
+    Ghs_stats stats;
+    return static_ghs(graph, rnd(0, std::numeric_limits<size_t>::max()), stats);
+}
+
+Graph_as_vector static_ghs(const Graph_as_vector& graph, size_t seed, Ghs_stats& stats)
+{
+    Static_ghs_emulator e(graph, seed);
+    e.process();
+
+    stats.round_num = e.get_round_num();
+    stats.message_num = e.get_message_num();
+    stats.time = e.get_time();
+    stats.phase_num = 0;
+
+    Graph_as_vector result(graph.get_node_num());
+    for(size_t i = 0; i < graph.get_node_num(); ++i)
+    {
+        result.add_edges(e[i].get_branches());
+        stats.phase_num = std::max(stats.phase_num, e[i].get_phase_num());
+    }
+
+    result.standartize();
+
+    return result;
+}
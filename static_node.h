@@ -0,0 +1,113 @@
+#ifndef STATIC_NODE_H_INCLUDED
+#define STATIC_NODE_H_INCLUDED
+
+#include <vector>
+#include <queue>
+#include <variant>
+#include <limits>
+
+#include "graph_as_vector.h"
+#include "static_emulator.h"
+#include "node.h"
+#include "ghs.h"
+
+struct Static_init
+{
+    Node::State state = Node::SLEEP;
+    Component component = Component(0, 0);
+};
+
+struct Static_change_core
+{
+};
+
+struct Static_connect
+{
+    Component component = Component(0, 0);
+};
+
+struct Static_reject
+{
+};
+
+struct Static_report
+{
+    size_t best_edge_weight = 0;
+};
+
+struct Static_test
+{
+    Component component = Component(0, 0);
+};
+
+struct Static_accept
+{
+};
+
+struct Static_end
+{
+};
+
+class Static_node
+{
+public:
+    typedef std::variant<Static_init, Static_change_core, Static_connect, Static_reject, Static_report, Static_test, Static_accept, Static_end> Message;
+    typedef Static_envelope<Message> Envelope;
+
+private:
+    struct Link
+    {
+        size_t end, weight;
+        Edge::State state;
+    };
+
+    static constexpr size_t UDEF = std::numeric_limits<size_t>::max();
+
+    size_t id, parent, best_edge_weight, best_edge, test_node, reports;
+    Node::State state;
+    bool checking_postponed;
+    Component component;
+
+    std::vector<Link> edges;
+    std::queue<Envelope> postponed;
+    std::vector<Envelope>* result;
+
+    size_t get_edge(size_t end) const;
+    size_t find_min_edge() const;
+    void send(size_t recipient, Message q);
+    void dispatch(const Envelope& q);
+    void test();
+    void report();
+    void change_core();
+    void check_postponed();
+    void wake_up();
+
+    void on(const Envelope& q, const Static_init& m);
+    void on(const Envelope& q, const Static_change_core& m);
+    void on(const Envelope& q, const Static_connect& m);
+    void on(const Envelope& q, const Static_reject& m);
+    void on(const Envelope& q, const Static_report& m);
+    void on(const Envelope& q, const Static_test& m);
+    void on(const Envelope& q, const Static_accept& m);
+    void on(const Envelope& q, const Static_end& m);
+
+public:
+    Static_node();
+
+    void set_id(size_t id_);
+    void add_edge(size_t end, size_t weight);
+    void tick(const Envelope& q, std::vector<Envelope>& out);
+    void wake_up(std::vector<Envelope>& out);
+    bool ended() const;
+    size_t get_priority() const;
+    size_t get_phase_num() const;
+
+    Graph_as_vector get_branches() const;
+};
+
+typedef Static_emulator<Static_node, Static_init, Static_change_core, Static_connect, Static_reject, Static_report, Static_test, Static_accept, Static_end> Static_ghs_emulator;
+
+Graph_as_vector static_ghs(const Graph_as_vector& graph);
+Graph_as_vector static_ghs(const Graph_as_vector& graph, size_t seed, Ghs_stats& stats);
+
+#endif // STATIC_NODE_H_INCLUDED
@@ -0,0 +1,217 @@
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+
+#include "trace.h"
+
+namespace
+{
+
+const char MAGIC[4] = {'G', 'H', 'S', 'T'};
+const unsigned char VERSION = 1;
+
+}
+
+Trace_writer::Trace_writer(const std::string& path, size_t node_num) : stream(path, std::ios::binary), named(256, false), last_round(0)
+{
+    if(!stream)
+        throw bad_trace();
+
+    buffer.reserve(BUFFER_SIZE);
+
+    for(char i : MAGIC)
+        put(i);
+    put(VERSION);
+    put_varint(node_num);
+}
+
+Trace_writer::~Trace_writer()
+{
+    flush();
+}
+
+void Trace_writer::put(unsigned char byte)
+{
+    if(buffer.size() == BUFFER_SIZE)
+        flush();
+    buffer.push_back(byte);
+}
+
+void Trace_writer::put_varint(size_t value)
+{
+    for(; value >= 0x80; value >>= 7)
+        put(static_cast<unsigned char>(value | 0x80));
+    put(static_cast<unsigned char>(value));
+}
+
+void Trace_writer::put_round(size_t round)
+{
+    put_varint(round - last_round);
+    last_round = round;
+}
+
+void Trace_writer::flush()
+{
+    stream.write(buffer.data(), buffer.size());
+    stream.flush();
+    buffer.clear();
+}
+
+void Trace_writer::wake_up(size_t round, size_t node, unsigned char state_before, unsigned char state_after)
+{
+    put(Trace_record::WAKE_UP);
+    put_round(round);
+    put_varint(node);
+    put(state_before);
+    put(state_after);
+}
+
+void Trace_writer::deliver(size_t round, size_t sender, size_t recipient, unsigned char type, const char* name, size_t first_payload, size_t second_payload, unsigned char state_before, unsigned char state_after)
+{
+    if(!named[type])
+    {
+        size_t length = std::strlen(name);
+
+        put(Trace_record::NAME);
+        put(type);
+        put_varint(length);
+        for(size_t i = 0; i < length; ++i)
+            put(name[i]);
+
+        named[type] = true;
+    }
+
+    put(Trace_record::DELIVERY);
+    put_round(round);
+    put_varint(sender);
+    put_varint(recipient);
+    put(type);
+    put_varint(first_payload);
+    put_varint(second_payload);
+    put(state_before);
+    put(state_after);
+}
+
+Trace_reader::Trace_reader(const std::string& path) : stream(path, std::ios::binary), buffer(BUFFER_SIZE), position(0), size(0), last_round(0), names(256)
+{
+    if(!stream)
+        throw bad_trace();
+
+    for(char i : MAGIC)
+        if(get() != static_cast<unsigned char>(i))
+            throw bad_trace();
+    if(get() != VERSION)
+        throw bad_trace();
+    node_num = get_varint();
+}
+
+bool Trace_reader::fill()
+{
+    if(position < size)
+        return true;
+
+    stream.read(buffer.data(), buffer.size());
+    size = stream.gcount();
+    position = 0;
+
+    return size != 0;
+}
+
+unsigned char Trace_reader::get()
+{
+    if(!fill())
+        throw bad_trace();
+    return static_cast<unsigned char>(buffer[position++]);
+}
+
+size_t Trace_reader::get_varint()
+{
+    size_t result = 0;
+    for(size_t shift = 0; ; shift += 7)
+    {
+        unsigned char byte = get();
+        result |= size_t(byte & 0x7F) << shift;
+        if(!(byte & 0x80))
+            return result;
+    }
+}
+
+bool Trace_reader::next(Trace_record& record)
+{
+    while(fill())
+    {
+        record.kind = static_cast<Trace_record::Kind>(get());
+
+        if(record.kind == Trace_record::NAME)
+        {
+            unsigned char type = get();
+            names[type].resize(get_varint());
+            for(char& i : names[type])
+                i = get();
+            continue;
+        }
+
+        last_round += get_varint();
+        record.round = last_round;
+
+        if(record.kind == Trace_record::WAKE_UP)
+        {
+            record.sender = record.recipient = get_varint();
+            record.type = 0;
+            record.payload[0] = record.payload[1] = 0;
+        }
+        else if(record.kind == Trace_record::DELIVERY)
+        {
+            record.sender = get_varint();
+            record.recipient = get_varint();
+            record.type = get();
+            record.payload[0] = get_varint();
+            record.payload[1] = get_varint();
+        }
+        else
+            throw bad_trace();
+
+        record.state_before = get();
+        record.state_after = get();
+
+        return true;
+    }
+
+    return false;
+}
+
+size_t Trace_reader::get_node_num() const
+{
+    return node_num;
+}
+
+const std::string& Trace_reader::get_name(unsigned char type) const
+{
+    return names[type];
+}
+
+void export_chrome_trace(Trace_reader& reader, std::ostream& stream)
+{
+    stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool first = true;
+    Trace_record record;
+    while(reader.next(record))
+    {
+        stream << (first ? "\n" : ",\n");
+        first = false;
+
+        if(record.kind == Trace_record::WAKE_UP)
+            stream << "{\"name\":\"WAKE_UP\",\"ph\":\"i\",\"s\":\"t\",\"ts\":" << record.round << ",\"pid\":0,\"tid\":" << record.recipient << "}";
+        else
+            stream << "{\"name\":\"" << reader.get_name(record.type) << "\",\"ph\":\"X\",\"ts\":" << record.round << ",\"dur\":1,\"pid\":0,\"tid\":" << record.recipient
+                   << ",\"args\":{\"sender\":" << record.sender << ",\"payload\":[" << record.payload[0] << "," << record.payload[1] << "]}}";
+
+        if(record.state_before != record.state_after)
+            stream << ",\n{\"name\":\"state " << int(record.state_before) << "->" << int(record.state_after) << "\",\"ph\":\"i\",\"s\":\"t\",\"ts\":" << record.round << ",\"pid\":0,\"tid\":" << record.recipient << "}";
+    }
+
+    stream << "\n]}\n";
+}
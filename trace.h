@@ -0,0 +1,74 @@
+#ifndef TRACE_H_INCLUDED
+#define TRACE_H_INCLUDED
+
+#include <cstddef>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+class bad_trace : public std::exception
+{
+};
+
+struct Trace_record
+{
+    enum Kind : unsigned char {DELIVERY, WAKE_UP, NAME};
+
+    Kind kind;
+    unsigned char type, state_before, state_after;
+    size_t round, sender, recipient;
+    size_t payload[2];
+};
+
+class Trace_writer
+{
+private:
+    static constexpr size_t BUFFER_SIZE = 1 << 20;
+
+    std::ofstream stream;
+    std::vector<char> buffer;
+    std::vector<bool> named;
+    size_t last_round;
+
+    void put(unsigned char byte);
+    void put_varint(size_t value);
+    void put_round(size_t round);
+
+public:
+    Trace_writer(const std::string& path, size_t node_num);
+    ~Trace_writer();
+
+    void wake_up(size_t round, size_t node, unsigned char state_before, unsigned char state_after);
+    void deliver(size_t round, size_t sender, size_t recipient, unsigned char type, const char* name, size_t first_payload, size_t second_payload, unsigned char state_before, unsigned char state_after);
+    void flush();
+};
+
+class Trace_reader
+{
+private:
+    static constexpr size_t BUFFER_SIZE = 1 << 20;
+
+    std::ifstream stream;
+    std::vector<char> buffer;
+    size_t position, size;
+    size_t node_num, last_round;
+    std::vector<std::string> names;
+
+    bool fill();
+    unsigned char get();
+    size_t get_varint();
+
+public:
+    Trace_reader(const std::string& path);
+
+    bool next(Trace_record& record);
+
+    size_t get_node_num() const;
+    const std::string& get_name(unsigned char type) const;
+};
+
+void export_chrome_trace(Trace_reader& reader, std::ostream& stream);
+
+#endif // TRACE_H_INCLUDED